@@ -557,8 +557,8 @@ void Chord::add(Element* e)
         if (voice() && measure() && note->visible()) {
             measure()->setHasVoices(staffIdx(), true);
         }
+        note->setPlaylistDirty();
     }
-        score()->setPlaylistDirty();
         break;
     case ElementType::ARPEGGIO:
         _arpeggio = toArpeggio(e);
@@ -632,6 +632,7 @@ void Chord::remove(Element* e)
         auto i = std::find(_notes.begin(), _notes.end(), note);
         if (i != _notes.end()) {
             _notes.erase(i);
+            note->setPlaylistDirty();
             note->disconnectTiedNotes();
             for (Spanner* s : note->spannerBack()) {
                 note->removeSpannerBack(s);
@@ -645,7 +646,6 @@ void Chord::remove(Element* e)
         if (voice() && measure() && note->visible()) {
             measure()->checkMultiVoices(staffIdx());
         }
-        score()->setPlaylistDirty();
     }
     break;
 
@@ -96,6 +96,28 @@ void CmdState::reset()
     _locked = false;
 }
 
+//---------------------------------------------------------
+//   restoreLayoutRange
+//    reset the tick and staff range to those of s; layout
+//    flags and the changed flags are kept. A dropped layout
+//    range still leaves a complete screen refresh.
+//---------------------------------------------------------
+
+void CmdState::restoreLayoutRange(const CmdState& s)
+{
+    _startTick      = s._startTick;
+    _endTick        = s._endTick;
+    _startStaff     = s._startStaff;
+    _endStaff       = s._endStaff;
+    _el             = s._el;
+    _oneElement     = s._oneElement;
+    _mb             = s._mb;
+    _oneMeasureBase = s._oneMeasureBase;
+    if (_updateMode == UpdateMode::Layout && s._updateMode != UpdateMode::Layout) {
+        _updateMode = UpdateMode::UpdateAll;
+    }
+}
+
 //---------------------------------------------------------
 //   setTick
 //---------------------------------------------------------
@@ -225,6 +247,9 @@ void Score::startCmd()
 
     cmdState().reset();
 
+    // edits are propagated to linked parts, so these must exist now
+    masterScore()->loadDeferredExcerpts();
+
     // Start collecting low-level undo operations for a
     // user-visible undo action.
     if (undoStack()->active()) {
@@ -250,7 +275,7 @@ void Score::undoRedo(bool undo, EditData* ed)
         undoStack()->redo(ed);
     }
     update(false);
-    masterScore()->setPlaylistDirty();    // TODO: flag all individual operations
+    masterScore()->setPlaylistDirty(cmdState());
     updateSelection();
 }
 
@@ -284,7 +309,7 @@ void Score::endCmd(const bool isCmdFromInspector, bool rollback)
     undoStack()->endMacro(noUndo);
 
     if (dirty()) {
-        masterScore()->setPlaylistDirty();      // TODO: flag individual operations
+        masterScore()->setPlaylistDirty(cmdState());
         masterScore()->setAutosaveDirty(true);
     }
     MuseScoreCore::mscoreCore->endCmd(isCmdFromInspector, rollback);
@@ -318,7 +343,11 @@ void Score::update(bool resetCmdState)
         ms->deletePostponed();
         if (cs.layoutRange()) {
             for (Score* s : ms->scoreList()) {
-                s->doLayoutRange(cs.startTick(), cs.endTick());
+                s->addPendingLayout(cs.startTick(), cs.endTick());
+                // part scores not on display are laid out when needed
+                if (!MScore::deferPartLayout || s == ms || s == this || s->isDisplayed()) {
+                    s->doPendingLayout();
+                }
             }
             updateAll = true;
         }
@@ -360,6 +389,55 @@ void Score::update(bool resetCmdState)
     }
 }
 
+//---------------------------------------------------------
+//   addPendingLayout
+//    remember a tick range to be laid out by doPendingLayout();
+//    as the edits in between may have moved measures, the
+//    ranges of several commands are joined up to the end
+//---------------------------------------------------------
+
+void Score::addPendingLayout(const Fraction& stick, const Fraction& etick)
+{
+    if (!_layoutPending) {
+        _pendingStartTick = stick;
+        _pendingEndTick   = etick;
+        _layoutPending    = true;
+    } else {
+        if (stick < _pendingStartTick) {
+            _pendingStartTick = stick;
+        }
+        _pendingEndTick = Fraction(-1, 1);
+    }
+}
+
+//---------------------------------------------------------
+//   doPendingLayout
+//---------------------------------------------------------
+
+void Score::doPendingLayout()
+{
+    if (!_layoutPending) {
+        return;
+    }
+    _layoutPending = false;
+    doLayoutRange(_pendingStartTick < Fraction(0, 1) ? Fraction(0, 1) : _pendingStartTick, _pendingEndTick);
+}
+
+//---------------------------------------------------------
+//   isDisplayed
+//    return true if one of the views shows the score
+//---------------------------------------------------------
+
+bool Score::isDisplayed() const
+{
+    for (MuseScoreView* v : viewer) {
+        if (v->isDisplayed()) {
+            return true;
+        }
+    }
+    return false;
+}
+
 //---------------------------------------------------------
 //   deletePostponed
 //---------------------------------------------------------
@@ -4111,6 +4189,7 @@ void Score::cmdAddPitch(int step, bool addFlag, bool insert)
 void Score::cmdToggleVisible()
 {
     QSet<Element*> spanners;
+    undoStack()->beginBulkEdit();
     for (Element* e : selection().elements()) {
         if (e->isBracket()) {       // ignore
             continue;
@@ -4127,6 +4206,7 @@ void Score::cmdToggleVisible()
             spanners.insert(toSpannerSegment(e)->spanner());
         }
     }
+    undoStack()->endBulkEdit();
 }
 
 //---------------------------------------------------------
@@ -4173,6 +4253,7 @@ void Score::cmdToggleAutoplace(bool all)
         setLayoutAll();
     } else {
         QSet<Element*> spanners;
+        undoStack()->beginBulkEdit();
         for (Element* e : selection().elements()) {
             if (e->isSpannerSegment()) {
                 if (Element* ee = e->propertyDelegate(Pid::AUTOPLACE)) {
@@ -4193,6 +4274,7 @@ void Score::cmdToggleAutoplace(bool all)
             }
             e->undoChangeProperty(Pid::AUTOPLACE, !e->getProperty(Pid::AUTOPLACE).toBool(), pf);
         }
+        undoStack()->endBulkEdit();
     }
 }
 
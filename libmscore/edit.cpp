@@ -3888,6 +3888,41 @@ void Score::undoPropertyChanged(ScoreElement* e, Pid t, const QVariant& st, Prop
     }
 }
 
+//---------------------------------------------------------
+//   undoChangeProperties
+///   Change a property of many elements in one bulk edit.
+///   Linked elements are visited once per link group and
+///   the changes are kept in a single ChangePropertyList.
+///   Without \p ps the flags of each element are kept.
+//---------------------------------------------------------
+
+static void changeProperties(UndoStack* undo, const std::vector<Element*>& elements, Pid id, const QVariant& v,
+                             const PropertyFlags* ps)
+{
+    QSet<const void*> done;
+    const bool linked = propertyLink(id);
+    undo->beginBulkEdit();
+    for (Element* e : elements) {
+        const void* key = (linked && e->links()) ? static_cast<const void*>(e->links()) : e;
+        if (done.contains(key)) {
+            continue;
+        }
+        done.insert(key);
+        e->undoChangeProperty(id, v, ps ? *ps : e->propertyFlags(id));
+    }
+    undo->endBulkEdit();
+}
+
+void Score::undoChangeProperties(const std::vector<Element*>& elements, Pid id, const QVariant& v)
+{
+    changeProperties(undoStack(), elements, id, v, nullptr);
+}
+
+void Score::undoChangeProperties(const std::vector<Element*>& elements, Pid id, const QVariant& v, PropertyFlags ps)
+{
+    changeProperties(undoStack(), elements, id, v, &ps);
+}
+
 //---------------------------------------------------------
 //   undoChangeStyleVal
 //---------------------------------------------------------
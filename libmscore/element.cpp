@@ -649,11 +649,10 @@ void Element::writeProperties(XmlWriter& xml) const
 bool Element::readProperties(XmlReader& e)
 {
     const QStringRef& tag(e.name());
+    const Pid pid = e.propertyTag();
 
-    if (readProperty(tag, e, Pid::SIZE_SPATIUM_DEPENDENT)) {
-    } else if (readProperty(tag, e, Pid::OFFSET)) {
-    } else if (readProperty(tag, e, Pid::MIN_DISTANCE)) {
-    } else if (readProperty(tag, e, Pid::AUTOPLACE)) {
+    if (pid == Pid::SIZE_SPATIUM_DEPENDENT || pid == Pid::OFFSET || pid == Pid::MIN_DISTANCE || pid == Pid::AUTOPLACE) {
+        readProperty(e, pid);
     } else if (tag == "track") {
         setTrack(e.readInt() + e.trackOffset());
     } else if (tag == "color") {
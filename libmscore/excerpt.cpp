@@ -49,8 +49,13 @@ namespace Ms {
 //---------------------------------------------------------
 
 Excerpt::Excerpt(const Excerpt& ex, bool copyPartScore)
-    : QObject(), _oscore(ex._oscore), _title(ex._title), _parts(ex._parts), _tracks(ex._tracks)
+    : QObject(), _oscore(ex._oscore), _title(ex._title)
 {
+    // parts and tracks of a deferred excerpt are only known
+    // after its part score is built
+    const_cast<Excerpt&>(ex).loadDeferred();
+    _parts = ex._parts;
+    _tracks = ex._tracks;
     _partScore = (copyPartScore && ex._partScore) ? ex._partScore->clone() : nullptr;
 }
 
@@ -124,6 +129,8 @@ bool Excerpt::operator==(const Excerpt& e) const
     if (e._title != _title) {
         return false;
     }
+    const_cast<Excerpt&>(e).loadDeferred();
+    const_cast<Excerpt*>(this)->loadDeferred();
     if (e._parts != _parts) {
         return false;
     }
@@ -145,6 +152,13 @@ void Excerpt::createExcerpt(Excerpt* excerpt)
     QList<Part*>& parts = excerpt->parts();
     QList<int> srcStaves;
 
+    // The part score is laid out completely below. The layout range
+    // added while building it is dropped at the end so that endCmd()
+    // does not lay out the master score and all other parts again:
+    // creating n parts would otherwise do O(n^2) part layouts.
+    const CmdState cmdState = oscore->cmdState();
+    bool frameInserted = false;
+
     // clone layer:
     for (int i = 0; i < 32; ++i) {
         score->layerTags()[i] = oscore->layerTags()[i];
@@ -211,6 +225,7 @@ void Excerpt::createExcerpt(Excerpt* excerpt)
         qDebug("original score has no header frame");
         oscore->insertMeasure(ElementType::VBOX, measure);
         measure = oscore->first();
+        frameInserted = true;
     }
     VBox* titleFrameScore = toVBox(measure);
 
@@ -305,6 +320,11 @@ void Excerpt::createExcerpt(Excerpt* excerpt)
 
     score->setLayoutAll();
     score->doLayout();
+
+    oscore->cmdState().restoreLayoutRange(cmdState);
+    if (frameInserted) {
+        oscore->setLayoutAll();         // the new title frame moves everything
+    }
 }
 
 //---------------------------------------------------------
@@ -1288,4 +1308,118 @@ void Excerpt::setPartScore(Score* s)
     _partScore = s;
     s->setExcerpt(this);
 }
+
+//---------------------------------------------------------
+//   partScore
+//    a deferred part score is built on first access
+//---------------------------------------------------------
+
+Score* Excerpt::partScore() const
+{
+    if (isDeferred()) {
+        const_cast<Excerpt*>(this)->loadDeferred();
+    }
+    return _partScore;
+}
+
+//---------------------------------------------------------
+//   writeCurrentToken
+//    copy the current token of e, which may read from
+//    cached XmlTokens, through the XmlReader interface
+//---------------------------------------------------------
+
+static void writeCurrentToken(QXmlStreamWriter& xml, const XmlReader& e)
+{
+    switch (e.tokenType()) {
+    case QXmlStreamReader::StartElement:
+        xml.writeStartElement(e.name().toString());
+        xml.writeAttributes(e.attributes());
+        break;
+    case QXmlStreamReader::EndElement:
+        xml.writeEndElement();
+        break;
+    case QXmlStreamReader::Characters:
+        if (e.isCDATA()) {
+            xml.writeCDATA(e.text().toString());
+        } else {
+            xml.writeCharacters(e.text().toString());
+        }
+        break;
+    case QXmlStreamReader::Comment:
+        xml.writeComment(e.text().toString());
+        break;
+    default:
+        break;
+    }
+}
+
+//---------------------------------------------------------
+//   readDeferred
+//    read a part <Score> element without building the
+//    part score: the element is kept as xml together
+//    with the link table of the master score and parsed
+//    when the part score is first needed
+//---------------------------------------------------------
+
+void Excerpt::readDeferred(XmlReader& e)
+{
+    for (auto i = e.staffLinkedElements().cbegin(); i != e.staffLinkedElements().cend(); ++i) {
+        if (i.key() >= 0) {                 // master score staves
+            _deferredLinks.insert(i.key(), i.value());
+        }
+    }
+
+    QXmlStreamWriter xml(&_deferredXml);
+    writeCurrentToken(xml, e);
+    int depth = 1;
+    bool readName = false;
+    QString name;
+    while (depth > 0 && !e.atEnd()) {
+        e.readNext();
+        if (e.isStartElement()) {
+            ++depth;
+            readName = depth == 2 && e.name() == "name";
+        } else if (e.isEndElement()) {
+            --depth;
+            readName = false;
+        } else if (readName && e.isCharacters()) {
+            name += e.text();
+        }
+        writeCurrentToken(xml, e);
+    }
+    _title = name;
+}
+
+//---------------------------------------------------------
+//   loadDeferred
+//---------------------------------------------------------
+
+void Excerpt::loadDeferred()
+{
+    if (!isDeferred()) {
+        return;
+    }
+    QByteArray data;
+    QMap<int, QList<QPair<LinkedElements*, Location> > > links;
+    data.swap(_deferredXml);
+    links.swap(_deferredLinks);
+
+    Score* score = new Score(_oscore, MScore::baseStyle());
+    setPartScore(score);
+
+    XmlReader e(data);
+    e.setDocName(_oscore->fileInfo()->completeBaseName());
+    e.staffLinkedElements() = links;
+    if (e.readNextStartElement()) {
+        score->read(e);
+    }
+    setTracks(e.tracks());
+    _oscore->initExcerpt(this);
+    _oscore->rebuildExcerptMidiMapping(score);
+
+    score->setPlaylistDirty();
+    score->addLayoutFlags(LayoutFlag::FIX_PITCH_VELO);
+    score->setLayoutAll();
+    score->doLayout();
+}
 }
@@ -16,6 +16,7 @@
 #include <QMultiMap>
 
 #include "fraction.h"
+#include "location.h"
 
 namespace Ms {
 class MasterScore;
@@ -25,6 +26,7 @@ class Measure;
 class XmlWriter;
 class Staff;
 class XmlReader;
+class LinkedElements;
 
 //---------------------------------------------------------
 //   @@ Excerpt
@@ -39,23 +41,31 @@ class Excerpt : public QObject
     QList<Part*> _parts;
     QMultiMap<int, int> _tracks;
 
+    // deferred loading, see readDeferred()
+    QByteArray _deferredXml;
+    QMap<int, QList<QPair<LinkedElements*, Location> > > _deferredLinks;
+
+    void loadDeferred();
+
 public:
     Excerpt(MasterScore* s = 0) { _oscore = s; }
     Excerpt(const Excerpt& ex, bool copyPartScore = true);
 
     ~Excerpt();
 
-    QList<Part*>& parts() { return _parts; }
+    QList<Part*>& parts() { loadDeferred(); return _parts; }
     void setParts(const QList<Part*>& p) { _parts = p; }
 
-    QMultiMap<int, int>& tracks() { return _tracks; }
+    QMultiMap<int, int>& tracks() { loadDeferred(); return _tracks; }
     void setTracks(const QMultiMap<int, int>& t) { _tracks = t; }
 
     MasterScore* oscore() const { return _oscore; }
-    Score* partScore() const { return _partScore; }
+    Score* partScore() const;
     void setPartScore(Score* s);
 
     void read(XmlReader&);
+    void readDeferred(XmlReader&);
+    bool isDeferred() const { return !_deferredXml.isEmpty(); }
 
     bool operator!=(const Excerpt&) const;
     bool operator==(const Excerpt&) const;
@@ -23,6 +23,7 @@
 #include "part.h"
 #include "utils.h"
 #include "sym.h"
+#include "textmetrics.h"
 #include "xml.h"
 
 namespace Ms {
@@ -1554,20 +1555,7 @@ TextSegment::TextSegment(const QString& s, const QFont& f, qreal x, qreal y)
 
 qreal TextSegment::width() const
 {
-    QFontMetricsF fm(font, MScore::paintDevice());
-#if 1
-    return fm.width(text);
-#else
-    qreal w = 0.0;
-    foreach (QChar c, text) {
-        // if we calculate width by character, at least skip high surrogates
-        if (c.isHighSurrogate()) {
-            continue;
-        }
-        w += fm.width(c);
-    }
-    return w;
-#endif
+    return TextMetrics::width(font, text);
 }
 
 //---------------------------------------------------------
@@ -1576,8 +1564,7 @@ qreal TextSegment::width() const
 
 QRectF TextSegment::boundingRect() const
 {
-    QFontMetricsF fm(font, MScore::paintDevice());
-    return fm.boundingRect(text);
+    return TextMetrics::boundingRect(font, text);
 }
 
 //---------------------------------------------------------
@@ -1586,8 +1573,7 @@ QRectF TextSegment::boundingRect() const
 
 QRectF TextSegment::tightBoundingRect() const
 {
-    QFontMetricsF fm(font, MScore::paintDevice());
-    return fm.tightBoundingRect(text);
+    return TextMetrics::tightBoundingRect(font, text);
 }
 
 //---------------------------------------------------------
@@ -109,9 +109,30 @@ QSizeF Image::imageSize() const
     if (!isValid()) {
         return QSizeF();
     }
+    if (imageType == ImageType::RASTER && !rasterDoc) {
+        return _storeItem->rasterSize();
+    }
     return imageType == ImageType::RASTER ? rasterDoc->size() : svgDoc->defaultSize();
 }
 
+//---------------------------------------------------------
+//   decodeRaster
+//    raster images are decoded only when they are drawn
+//    for the first time
+//---------------------------------------------------------
+
+void Image::decodeRaster() const
+{
+    if (rasterDoc || !_storeItem) {
+        return;
+    }
+    rasterDoc = new QImage;
+    rasterDoc->loadFromData(_storeItem->buffer());
+    if (!rasterDoc->isNull()) {
+        _dirty = true;
+    }
+}
+
 //---------------------------------------------------------
 //   draw
 //---------------------------------------------------------
@@ -119,6 +140,9 @@ QSizeF Image::imageSize() const
 void Image::draw(QPainter* painter) const
 {
     bool emptyImage = false;
+    if (imageType == ImageType::RASTER) {
+        decodeRaster();
+    }
     if (imageType == ImageType::SVG) {
         if (!svgDoc) {
             emptyImage = true;
@@ -520,14 +544,6 @@ void Image::layout()
         if (_storeItem) {
             svgDoc = new QSvgRenderer(_storeItem->buffer());
         }
-    } else if (imageType == ImageType::RASTER && !rasterDoc) {
-        if (_storeItem) {
-            rasterDoc = new QImage;
-            rasterDoc->loadFromData(_storeItem->buffer());
-            if (!rasterDoc->isNull()) {
-                _dirty = true;
-            }
-        }
     }
     if (_size.isNull()) {
         _size = pixel2size(imageSize());
@@ -29,13 +29,14 @@ enum class ImageType : char {
 class Image final : public BSymbol
 {
     union {
-        QImage* rasterDoc;
+        mutable QImage* rasterDoc;      // decoded lazily on first draw
         QSvgRenderer* svgDoc;
     };
     ImageType imageType;
 
     QSizeF pixel2size(const QSizeF& s) const;
     QSizeF size2pixel(const QSizeF& s) const;
+    void decodeRaster() const;
 
 protected:
     ImageStoreItem* _storeItem;
@@ -92,7 +93,7 @@ public:
 
     void setImageType(ImageType);
     ImageType getImageType() const { return imageType; }
-    bool isValid() const { return rasterDoc || svgDoc; }
+    bool isValid() const { return rasterDoc || svgDoc || (imageType == ImageType::RASTER && _storeItem); }
 
     Element::EditBehavior normalModeEditBehavior() const override { return Element::EditBehavior::Edit; }
     int gripsCount() const override { return 2; }
@@ -10,7 +10,9 @@
 //  the file LICENCE.GPL
 //=============================================================================
 
+#include <QtCore/QBuffer>
 #include <QtCore/QCryptographicHash>
+#include <QtGui/QImageReader>
 #include "imageStore.h"
 #include "score.h"
 #include "image.h"
@@ -62,12 +64,76 @@ bool ImageStoreItem::isUsed(Score* score) const
     return false;
 }
 
+//---------------------------------------------------------
+//   set
+//---------------------------------------------------------
+
+void ImageStoreItem::set(const QByteArray& b, const QByteArray& h)
+{
+    _pending       = false;
+    _pendingBuffer = QFuture<QByteArray>();
+    _buffer        = b;
+    _hash          = h;
+    _rasterSize    = QSize();
+}
+
+//---------------------------------------------------------
+//   setPending
+//    the image data is still being produced (for example
+//    inflated from a .mscz in a worker thread); the hash
+//    must already be known so that the item can be looked
+//    up without waiting for the data
+//---------------------------------------------------------
+
+void ImageStoreItem::setPending(const QFuture<QByteArray>& f, const QByteArray& h)
+{
+    _pending       = true;
+    _pendingBuffer = f;
+    _buffer.clear();
+    _hash          = h;
+    _rasterSize    = QSize();
+}
+
+//---------------------------------------------------------
+//   sync
+//    wait for pending image data
+//---------------------------------------------------------
+
+void ImageStoreItem::sync() const
+{
+    if (!_pending) {
+        return;
+    }
+    _buffer        = _pendingBuffer.result();
+    _pendingBuffer = QFuture<QByteArray>();
+    _pending       = false;
+}
+
+//---------------------------------------------------------
+//   rasterSize
+//    size of a raster image in pixels; only the image
+//    header is read, the image is not decoded
+//---------------------------------------------------------
+
+QSize ImageStoreItem::rasterSize() const
+{
+    if (!_rasterSize.isValid()) {
+        QBuffer b;
+        b.setData(buffer());
+        b.open(QIODevice::ReadOnly);
+        QImageReader reader(&b);
+        _rasterSize = reader.size();
+    }
+    return _rasterSize;
+}
+
 //---------------------------------------------------------
 //   load
 //---------------------------------------------------------
 
 void ImageStoreItem::load()
 {
+    sync();
     if (!_buffer.isEmpty()) {
         return;
     }
@@ -122,6 +188,26 @@ inline static int toInt(char c)
     return c - 'a' + 10;
 }
 
+//---------------------------------------------------------
+//   hashFromName
+//    images are stored under their hash name, see
+//    ImageStoreItem::hashName(); return an empty array
+//    if path is not a hash name
+//---------------------------------------------------------
+
+static QByteArray hashFromName(const QString& path)
+{
+    QString s = QFileInfo(path).completeBaseName();
+    if (s.size() != 32) {
+        return QByteArray();
+    }
+    QByteArray hash(16, 0);
+    for (int i = 0; i < 16; ++i) {
+        hash[i] = toInt(s[i * 2].toLatin1()) * 16 + toInt(s[i * 2 + 1].toLatin1());
+    }
+    return hash;
+}
+
 #if 0
 //---------------------------------------------------------
 //   dumpHash
@@ -156,8 +242,8 @@ ImageStore::~ImageStore()
 
 ImageStoreItem* ImageStore::getImage(const QString& path) const
 {
-    QString s = QFileInfo(path).completeBaseName();
-    if (s.size() != 32) {
+    QByteArray hash = hashFromName(path);
+    if (hash.isEmpty()) {
         //
         // some limited support for backward compatibility
         //
@@ -167,17 +253,13 @@ ImageStoreItem* ImageStore::getImage(const QString& path) const
             }
         }
         qDebug("ImageStore::getImage(%s): bad base name <%s>",
-               qPrintable(path), qPrintable(s));
+               qPrintable(path), qPrintable(QFileInfo(path).completeBaseName()));
         for (ImageStoreItem* item : _items) {
             qDebug("    in store: <%s>", qPrintable(item->path()));
         }
 
         return 0;
     }
-    QByteArray hash(16, 0);
-    for (int i = 0; i < 16; ++i) {
-        hash[i] = toInt(s[i * 2].toLatin1()) * 16 + toInt(s[i * 2 + 1].toLatin1());
-    }
     for (ImageStoreItem* item : _items) {
         if (item->hash() == hash) {
             return item;
@@ -207,6 +289,29 @@ ImageStoreItem* ImageStore::add(const QString& path, const QByteArray& ba)
     return item;
 }
 
+//---------------------------------------------------------
+//   addPending
+//    add an image whose data is not yet available;
+//    the data is only waited for when it is first used
+//---------------------------------------------------------
+
+ImageStoreItem* ImageStore::addPending(const QString& path, const QFuture<QByteArray>& f)
+{
+    QByteArray hash = hashFromName(path);
+    if (hash.isEmpty()) {
+        return add(path, f.result());
+    }
+    for (ImageStoreItem* item : _items) {
+        if (item->hash() == hash) {
+            return item;
+        }
+    }
+    ImageStoreItem* item = new ImageStoreItem(path);
+    item->setPending(f, hash);
+    _items.push_back(item);
+    return item;
+}
+
 //---------------------------------------------------------
 //   clearUnused
 //---------------------------------------------------------
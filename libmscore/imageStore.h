@@ -26,8 +26,13 @@ class ImageStoreItem
     QList<Image*> _references;
     QString _path;                  // original location of image
     QString _type;                  // image type (file extension)
-    QByteArray _buffer;
+    mutable QByteArray _buffer;
     QByteArray _hash;               // 16 byte md4 hash of _buffer
+    mutable QFuture<QByteArray> _pendingBuffer;     // _buffer still being inflated
+    mutable bool _pending { false };
+    mutable QSize _rasterSize;      // cached image dimensions, see rasterSize()
+
+    void sync() const;
 
 public:
     ImageStoreItem(const QString& p);
@@ -35,16 +40,18 @@ public:
     void reference(Image*);
 
     const QString& path() const { return _path; }
-    QByteArray& buffer() { return _buffer; }
-    const QByteArray& buffer() const { return _buffer; }
-    bool loaded() const { return !_buffer.isEmpty(); }
+    QByteArray& buffer() { sync(); return _buffer; }
+    const QByteArray& buffer() const { sync(); return _buffer; }
+    bool loaded() const { sync(); return !_buffer.isEmpty(); }
     void setPath(const QString& val);
     bool isUsed(Score*) const;
     bool isUsed() const { return !_references.empty(); }
     void load();
     QString hashName() const;
     const QByteArray& hash() const { return _hash; }
-    void set(const QByteArray& b, const QByteArray& h) { _buffer = b; _hash = h; }
+    void set(const QByteArray& b, const QByteArray& h);
+    void setPending(const QFuture<QByteArray>& f, const QByteArray& h);
+    QSize rasterSize() const;
 };
 
 //---------------------------------------------------------
@@ -64,6 +71,7 @@ public:
 
     ImageStoreItem* getImage(const QString& path) const;
     ImageStoreItem* add(const QString& path, const QByteArray&);
+    ImageStoreItem* addPending(const QString& path, const QFuture<QByteArray>&);
     void clearUnused();
 
     typedef ItemList::iterator iterator;
@@ -4651,6 +4651,13 @@ void Score::doLayoutRange(const Fraction& st, const Fraction& et)
     Fraction etick(et);
     Q_ASSERT(!(stick == Fraction(-1,1) && etick == Fraction(-1,1)));
 
+    // the first page is kept if the layout starts after it
+    if (!_thumbnail.isNull()
+        && (layoutMode() != LayoutMode::PAGE || pages().isEmpty() || pages().front()->systems().empty()
+            || stick <= pages().front()->endTick())) {
+        _thumbnail = QImage();
+    }
+
     if (!last() || (lineMode() && !firstMeasure())) {
         qDebug("empty score");
         qDeleteAll(_systems);
@@ -89,5 +89,23 @@ public:
     bool operator==(const Location& other) const;
     bool operator!=(const Location& other) const { return !(*this == other); }
 };
+
+//---------------------------------------------------------
+//   qHash
+//    consistent with Location::operator==, which compares
+//    fractions by value
+//---------------------------------------------------------
+
+inline uint qHash(const Location& l, uint seed = 0)
+{
+    uint h = seed;
+    h = 31 * h + uint(l.staff());
+    h = 31 * h + uint(l.voice());
+    h = 31 * h + uint(l.measure());
+    h = 31 * h + uint(l.graceIndex());
+    h = 31 * h + uint(l.note());
+    const Fraction f = l.frac();
+    return 31 * h + (f.denominator() ? ::qHash(double(f.numerator()) / f.denominator()) : 0u);
+}
 }     // namespace Ms
 #endif
@@ -138,28 +138,42 @@ int MasterScore::getNextFreeDrumMidiMapping()
 void MasterScore::rebuildExcerptsMidiMapping()
 {
     for (Excerpt* ex : excerpts()) {
-        for (Part* p : ex->partScore()->parts()) {
-            const Part* masterPart = p->masterPart();
-            if (!masterPart->score()->isMaster()) {
-                qWarning() << "rebuildExcerptsMidiMapping: no part in master score is linked with " << p->partName();
+        if (ex->isDeferred()) {         // synced when the part score is loaded
+            continue;
+        }
+        rebuildExcerptMidiMapping(ex->partScore());
+    }
+}
+
+//---------------------------------------------------------
+//   rebuildExcerptMidiMapping
+//    copy the channels of the master score parts to the
+//    linked parts of partScore
+//---------------------------------------------------------
+
+void MasterScore::rebuildExcerptMidiMapping(Score* partScore)
+{
+    for (Part* p : partScore->parts()) {
+        const Part* masterPart = p->masterPart();
+        if (!masterPart->score()->isMaster()) {
+            qWarning() << "rebuildExcerptsMidiMapping: no part in master score is linked with " << p->partName();
+            continue;
+        }
+        Q_ASSERT(p->instruments()->size() == masterPart->instruments()->size());
+        for (const auto& item : *masterPart->instruments()) {
+            const Instrument* iMaster = item.second;
+            const int tick = item.first;
+            Instrument* iLocal = p->instrument(Fraction::fromTicks(tick));
+            const int nchannels = iMaster->channel().size();
+            if (iLocal->channel().size() != nchannels) {
+                // may happen, e.g., if user changes an instrument
+                (*iLocal) = (*iMaster);
                 continue;
             }
-            Q_ASSERT(p->instruments()->size() == masterPart->instruments()->size());
-            for (const auto& item : *masterPart->instruments()) {
-                const Instrument* iMaster = item.second;
-                const int tick = item.first;
-                Instrument* iLocal = p->instrument(Fraction::fromTicks(tick));
-                const int nchannels = iMaster->channel().size();
-                if (iLocal->channel().size() != nchannels) {
-                    // may happen, e.g., if user changes an instrument
-                    (*iLocal) = (*iMaster);
-                    continue;
-                }
-                for (int c = 0; c < nchannels; ++c) {
-                    Channel* cLocal = iLocal->channel(c);
-                    const Channel* cMaster = iMaster->channel(c);
-                    cLocal->setChannel(cMaster->channel());
-                }
+            for (int c = 0; c < nchannels; ++c) {
+                Channel* cLocal = iLocal->channel(c);
+                const Channel* cMaster = iMaster->channel(c);
+                cLocal->setChannel(cMaster->channel());
             }
         }
     }
@@ -108,6 +108,10 @@ int MScore::sampleRate  = 44100;
 int MScore::mtcType;
 
 bool MScore::noExcerpts = false;
+bool MScore::deferExcerpts = false;
+bool MScore::useScoreCache = false;
+bool MScore::deferPartLayout = false;
+size_t MScore::undoMemoryLimit = 0;
 bool MScore::noImages = false;
 bool MScore::pdfPrinting = false;
 bool MScore::svgPrinting = false;
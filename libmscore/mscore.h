@@ -370,6 +370,10 @@ public:
     static bool noGui;
 
     static bool noExcerpts;
+    static bool deferExcerpts;          // build part scores on first use
+    static bool useScoreCache;          // see ScoreCache
+    static bool deferPartLayout;        // lay out part scores not on display when needed
+    static size_t undoMemoryLimit;      // bytes held by the undo stack before old commands are dropped, 0: no limit
     static bool noImages;
 
     static bool pdfPrinting;
@@ -49,6 +49,7 @@ public:
 
     virtual void adjustCanvasPosition(const Element*, bool /*playBack*/, int /*staffIdx*/ = -1) {}
     virtual void setScore(Score* s) { _score = s; }
+    virtual bool isDisplayed() const { return true; }
     Score* score() const { return _score; }
     virtual void removeScore() {}
 
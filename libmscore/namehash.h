@@ -0,0 +1,95 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  Copyright (C) 2020 MuseScore BVBA
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2
+//  as published by the Free Software Foundation and appearing in
+//  the file LICENCE.GPL
+//=============================================================================
+
+#ifndef __NAMEHASH_H__
+#define __NAMEHASH_H__
+
+namespace Ms {
+//---------------------------------------------------------
+//   nameHash
+//    FNV-1a hash of an xml name
+//---------------------------------------------------------
+
+inline unsigned nameHash(const char* s)
+{
+    unsigned h = 2166136261u;
+    for (; *s; ++s) {
+        h = (h ^ static_cast<unsigned char>(*s)) * 16777619u;
+    }
+    return h;
+}
+
+inline unsigned nameHash(const QStringRef& s)
+{
+    unsigned h = 2166136261u;
+    const QChar* c = s.unicode();
+    for (int i = 0; i < s.size(); ++i) {
+        h = (h ^ c[i].unicode()) * 16777619u;
+    }
+    return h;
+}
+
+//---------------------------------------------------------
+//   NameIndex
+//    open addressing hash table mapping the xml names
+//    of a static table (properties, styles) to their index
+//---------------------------------------------------------
+
+class NameIndex
+{
+    struct Entry {
+        const char* name { nullptr };
+        unsigned hash    { 0 };
+        int value        { -1 };
+    };
+    std::vector<Entry> _entries;
+    unsigned _mask;
+
+public:
+    NameIndex(int n)
+    {
+        unsigned size = 16;
+        while (size < unsigned(n) * 2) {
+            size *= 2;
+        }
+        _entries.resize(size);
+        _mask = size - 1;
+    }
+
+    void insert(const char* name, int value)
+    {
+        const unsigned h = nameHash(name);
+        unsigned i = h & _mask;
+        while (_entries[i].name) {
+            if (_entries[i].hash == h && !strcmp(_entries[i].name, name)) {
+                return;                 // first entry wins
+            }
+            i = (i + 1) & _mask;
+        }
+        _entries[i].name  = name;
+        _entries[i].hash  = h;
+        _entries[i].value = value;
+    }
+
+    int value(const QStringRef& name) const      // -1 if not found
+    {
+        const unsigned h = nameHash(name);
+        for (unsigned i = h & _mask; _entries[i].name; i = (i + 1) & _mask) {
+            if (_entries[i].hash == h && name == QLatin1String(_entries[i].name)) {
+                return _entries[i].value;
+            }
+        }
+        return -1;
+    }
+};
+}     // namespace Ms
+#endif
@@ -769,7 +769,7 @@ void Note::setPitch(int val)
     Q_ASSERT(pitchIsValid(val));
     if (_pitch != val) {
         _pitch = val;
-        score()->setPlaylistDirty();
+        setPlaylistDirty();
     }
 }
 
@@ -1139,6 +1139,22 @@ Fraction Note::playTicksFraction() const
     return note->chord()->tick() + note->chord()->actualTicks() - stick;
 }
 
+//---------------------------------------------------------
+//   setPlaylistDirty
+///   Mark playback of the tie chain of this note as changed
+//---------------------------------------------------------
+
+void Note::setPlaylistDirty() const
+{
+    const Note* first = firstTiedNote();
+    const Note* last = lastTiedNote();
+    if (!first->chord() || !last->chord()) {
+        score()->setPlaylistDirty();
+        return;
+    }
+    score()->setPlaylistDirty(first->chord()->tick(), last->chord()->tick() + last->chord()->actualTicks());
+}
+
 //---------------------------------------------------------
 //   addSpanner
 //---------------------------------------------------------
@@ -2946,7 +2962,7 @@ bool Note::setProperty(Pid propertyId, const QVariant& v)
     switch (propertyId) {
     case Pid::PITCH:
         setPitch(v.toInt());
-        score()->setPlaylistDirty();
+        setPlaylistDirty();
         break;
     case Pid::TPC1:
         _tpc[0] = v.toInt();
@@ -2975,11 +2991,11 @@ bool Note::setProperty(Pid propertyId, const QVariant& v)
         break;
     case Pid::VELO_OFFSET:
         setVeloOffset(v.toInt());
-        score()->setPlaylistDirty();
+        setPlaylistDirty();
         break;
     case Pid::TUNING:
         setTuning(v.toDouble());
-        score()->setPlaylistDirty();
+        setPlaylistDirty();
         break;
     case Pid::FRET:
         setFret(v.toInt());
@@ -2995,7 +3011,7 @@ bool Note::setProperty(Pid propertyId, const QVariant& v)
         break;
     case Pid::VELO_TYPE:
         setVeloType(ValueType(v.toInt()));
-        score()->setPlaylistDirty();
+        setPlaylistDirty();
         break;
     case Pid::VISIBLE: {
         setVisible(v.toBool());
@@ -3006,7 +3022,7 @@ bool Note::setProperty(Pid propertyId, const QVariant& v)
     }
     case Pid::PLAY:
         setPlay(v.toBool());
-        score()->setPlaylistDirty();
+        setPlaylistDirty();
         break;
     case Pid::FIXED:
         setFixed(v.toBool());
@@ -342,6 +342,7 @@ public:
     void setTrack(int val) override;
 
     int playTicks() const;
+    void setPlaylistDirty() const;
     Fraction playTicksFraction() const;
 
     qreal headWidth() const;
@@ -0,0 +1,268 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  Copyright (C) 2020 MuseScore BVBA
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2
+//  as published by the Free Software Foundation and appearing in
+//  the file LICENCE.GPL
+//=============================================================================
+
+#include "config.h"
+#include "pagerender.h"
+#include "page.h"
+#include "score.h"
+#include "mscore.h"
+
+namespace Ms {
+//---------------------------------------------------------
+//   paintElements
+//---------------------------------------------------------
+
+static void paintElements(QPainter& p, const QList<Element*>& el)
+{
+    for (Element* e : el) {
+        if (!e->visible()) {
+            continue;
+        }
+        QPointF pos(e->pagePos());
+        p.translate(pos);
+        e->draw(&p);
+        p.translate(-pos);
+    }
+}
+
+//---------------------------------------------------------
+//   bandElements
+//    the elements of el which may paint into r; the bounding
+//    box is enlarged by a spatium for pen widths and
+//    antialiasing outside of it
+//---------------------------------------------------------
+
+static QList<Element*> bandElements(const QList<Element*>& el, const QRectF& r)
+{
+    QList<Element*> bel;
+    for (Element* e : el) {
+        if (!e->visible()) {
+            continue;
+        }
+        const qreal m = e->spatium();
+        if (e->pageBoundingRect().adjusted(-m, -m, m, m).intersects(r)) {
+            bel.append(e);
+        }
+    }
+    return bel;
+}
+
+//---------------------------------------------------------
+//   paintImage
+//    paint the page elements el into image. The image is
+//    split into bands of rows which are painted concurrently,
+//    each by its own painter on the rows of the image and
+//    with only the elements reaching into these rows.
+//    The global thread pool limits the number of bands.
+//---------------------------------------------------------
+
+static void paintImage(QImage& image, const QList<Element*>& el, qreal mag, const QPointF& origin)
+{
+    struct Band {
+        uchar* bits;
+        int y;
+        int height;
+    };
+    static const int MIN_BAND_HEIGHT = 128;
+
+    auto paint = [mag, origin](QPaintDevice* pd, int y, const QList<Element*>& pel) {
+                     QPainter p(pd);
+                     p.setRenderHint(QPainter::Antialiasing, true);
+                     p.setRenderHint(QPainter::TextAntialiasing, true);
+                     p.translate(0.0, -y);
+                     p.scale(mag, mag);
+                     p.translate(-origin);
+                     paintElements(p, pel);
+                 };
+
+    int n = qMin(QThreadPool::globalInstance()->maxThreadCount(), image.height() / MIN_BAND_HEIGHT);
+    for (const Element* e : el) {
+        if (e->isImage()) {             // keeps a cached rendering which is not thread safe
+            n = 1;
+            break;
+        }
+    }
+    if (n <= 1) {
+        paint(&image, 0, el);
+        return;
+    }
+
+    std::vector<Band> bands;
+    const int bandHeight = (image.height() + n - 1) / n;
+    uchar* bits = image.bits();
+    for (int y = 0; y < image.height(); y += bandHeight) {
+        bands.push_back({ bits + y * image.bytesPerLine(), y, qMin(bandHeight, image.height() - y) });
+    }
+    QtConcurrent::blockingMap(bands, [&image, &el, &paint, mag, origin](const Band& b) {
+                                  QImage band(b.bits, image.width(), b.height, image.bytesPerLine(), image.format());
+                                  band.setDotsPerMeterX(image.dotsPerMeterX());
+                                  band.setDotsPerMeterY(image.dotsPerMeterY());
+                                  const QRectF r(origin.x(), origin.y() + b.y / mag, image.width() / mag, b.height / mag);
+                                  paint(&band, b.y, bandElements(el, r));
+                              });
+}
+
+//---------------------------------------------------------
+//   image
+//    render page at dpi; with trimMargin >= 0 the image is
+//    cropped to the page content plus trimMargin pixels
+//---------------------------------------------------------
+
+QImage PageRender::image(Page* page, qreal dpi, bool transparent, int trimMargin)
+{
+    Score* score = page->score();
+    score->setPrinting(true);         // don’t print page break symbols etc.
+    const qreal pr = MScore::pixelRatio;
+
+    QRectF r;
+    if (trimMargin >= 0) {
+        QMarginsF margins(trimMargin, trimMargin, trimMargin, trimMargin);
+        r = page->tbbox() + margins;
+    } else {
+        r = page->abbox();
+    }
+    const int w = lrint(r.width() * dpi / DPI);
+    const int h = lrint(r.height() * dpi / DPI);
+
+    QImage image(w, h, QImage::Format_ARGB32_Premultiplied);
+    image.setDotsPerMeterX(lrint((dpi * 1000) / INCH));
+    image.setDotsPerMeterY(lrint((dpi * 1000) / INCH));
+    image.fill(transparent ? 0 : 0xffffffff);
+
+    const qreal mag = dpi / DPI;
+    MScore::pixelRatio = 1.0 / mag;
+
+    QList<Element*> el = page->elements();
+    std::stable_sort(el.begin(), el.end(), elementLessThan);
+    paintImage(image, el, mag, trimMargin >= 0 ? r.topLeft() : QPointF());
+
+    score->setPrinting(false);
+    MScore::pixelRatio = pr;
+    return image;
+}
+
+//---------------------------------------------------------
+//   PdfPage
+//---------------------------------------------------------
+
+struct PdfPage {
+    Score* score;
+    QList<Element*> elements;
+    bool hasImage { false };
+    QPicture picture;
+};
+
+//---------------------------------------------------------
+//   recordPage
+//    paint page into its picture in DPI coordinates
+//---------------------------------------------------------
+
+static void recordPage(PdfPage& page)
+{
+    QPainter p(&page.picture);
+    p.setRenderHint(QPainter::Antialiasing, true);
+    p.setRenderHint(QPainter::TextAntialiasing, true);
+    paintElements(p, page.elements);
+}
+
+//---------------------------------------------------------
+//   pdf
+//    write all pages of scores into one PDF document;
+//    each score gets its own page size.
+//    The pages are painted concurrently into pictures which
+//    are then played back in order into the one PDF stream;
+//    the PDF engine embeds each font subset once at the end.
+//    A global thread pool of one thread records serially.
+//---------------------------------------------------------
+
+bool PageRender::pdf(const QList<Score*>& scores, QIODevice* device, int dpi, const QString& title)
+{
+    if (scores.empty()) {
+        return false;
+    }
+    QPdfWriter writer(device);
+    writer.setResolution(dpi);
+    writer.setCreator("MuseScore Version: " VERSION);
+    writer.setTitle(title);
+    writer.setPageMargins(QMarginsF());
+
+    auto setPageSize = [&writer](Score* s) {
+                           QSizeF size(s->styleD(Sid::pageWidth), s->styleD(Sid::pageHeight));
+                           // landscape sizes stay custom sizes in portrait orientation
+                           writer.setPageSize(QPageSize(size, QPageSize::Inch));
+                           return size;
+                       };
+    setPageSize(scores.front());
+
+    // collecting the page items may rebuild the page bsp trees
+    std::vector<PdfPage> pages;
+    for (Score* s : scores) {
+        s->setPrinting(true);
+        for (Page* page : s->pages()) {
+            PdfPage pp;
+            pp.score    = s;
+            pp.elements = page->items(page->abbox());
+            std::stable_sort(pp.elements.begin(), pp.elements.end(), elementLessThan);
+            for (const Element* e : pp.elements) {
+                if (e->isImage()) {     // keeps a cached rendering which is not thread safe
+                    pp.hasImage = true;
+                    break;
+                }
+            }
+            pages.push_back(pp);
+        }
+    }
+
+    const qreal pr = MScore::pixelRatio;
+    const bool pdfPrinting = MScore::pdfPrinting;
+    MScore::pdfPrinting = true;
+    MScore::pixelRatio  = DPI / QPicture().logicalDpiX();
+    const bool concurrent = QThreadPool::globalInstance()->maxThreadCount() > 1;
+    if (concurrent) {
+        QtConcurrent::blockingMap(pages, [](PdfPage& page) {
+                                      if (!page.hasImage) {
+                                          recordPage(page);
+                                      }
+                                  });
+    }
+    for (PdfPage& page : pages) {
+        if (!concurrent || page.hasImage) {
+            recordPage(page);
+        }
+    }
+    MScore::pixelRatio  = pr;
+    MScore::pdfPrinting = pdfPrinting;
+    for (Score* s : scores) {
+        s->setPrinting(false);
+    }
+
+    QPainter p;
+    if (!p.begin(&writer)) {
+        return false;
+    }
+    Score* score = nullptr;
+    for (const PdfPage& page : pages) {
+        if (page.score != score) {
+            const QSizeF size = setPageSize(page.score);
+            p.setViewport(QRect(0.0, 0.0, size.width() * writer.logicalDpiX(), size.height() * writer.logicalDpiY()));
+            p.setWindow(QRect(0.0, 0.0, size.width() * DPI, size.height() * DPI));
+        }
+        if (score) {
+            writer.newPage();
+        }
+        score = page.score;
+        p.drawPicture(0, 0, page.picture);
+    }
+    p.end();
+    return true;
+}
+}
@@ -0,0 +1,34 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  Copyright (C) 2020 MuseScore BVBA
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2
+//  as published by the Free Software Foundation and appearing in
+//  the file LICENCE.GPL
+//=============================================================================
+
+#ifndef __PAGERENDER_H__
+#define __PAGERENDER_H__
+
+namespace Ms {
+class Page;
+class Score;
+
+//---------------------------------------------------------
+//   PageRender
+//    paints the pages of laid out scores into raster
+//    images and PDF; needs QtGui only, no widgets, no
+//    printer support and no editor
+//---------------------------------------------------------
+
+class PageRender
+{
+public:
+    static QImage image(Page*, qreal dpi, bool transparent = false, int trimMargin = -1);
+    static bool pdf(const QList<Score*>&, QIODevice*, int dpi, const QString& title);
+};
+}     // namespace Ms
+#endif
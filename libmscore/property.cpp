@@ -28,6 +28,7 @@
 #include "style.h"
 #include "sym.h"
 #include "changeMap.h"
+#include "namehash.h"
 #include "fret.h"
 
 namespace Ms {
@@ -619,17 +620,30 @@ static constexpr PropertyMetaData propertyList[] = {
 };
 
 //---------------------------------------------------------
-//   propertyId
+//   propertyIndex
+//    hash table of the property names, built on first use
 //---------------------------------------------------------
 
-Pid propertyId(const QStringRef& s)
+static NameIndex propertyIndex()
 {
+    NameIndex index(int(Pid::END));
     for (const PropertyMetaData& pd : propertyList) {
-        if (pd.name == s) {
-            return pd.id;
+        if (pd.id != Pid::END) {
+            index.insert(pd.name, int(pd.id));
         }
     }
-    return Pid::END;
+    return index;
+}
+
+//---------------------------------------------------------
+//   propertyId
+//---------------------------------------------------------
+
+Pid propertyId(const QStringRef& s)
+{
+    static const NameIndex index = propertyIndex();
+    const int idx = index.value(s);
+    return idx == -1 ? Pid::END : Pid(idx);
 }
 
 //---------------------------------------------------------
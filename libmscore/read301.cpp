@@ -156,13 +156,17 @@ bool Score::read(XmlReader& e)
             } else {
                 e.tracks().clear();             // ???
                 MasterScore* m = masterScore();
-                Score* s       = new Score(m, MScore::baseStyle());
                 Excerpt* ex    = new Excerpt(m);
 
-                ex->setPartScore(s);
-                e.setLastMeasure(nullptr);
-                s->read(e);
-                ex->setTracks(e.tracks());
+                if (MScore::deferExcerpts) {
+                    ex->readDeferred(e);
+                } else {
+                    Score* s = new Score(m, MScore::baseStyle());
+                    ex->setPartScore(s);
+                    e.setLastMeasure(nullptr);
+                    s->read(e);
+                    ex->setTracks(e.tracks());
+                }
                 m->addExcerpt(ex);
             }
         } else if (tag == "name") {
@@ -2548,6 +2548,26 @@ void RangeMap::setOccupied(int tick1, int tick2)
     }
 }
 
+//---------------------------------------------------------
+//   RangeMap::setUnoccupied
+//---------------------------------------------------------
+
+void RangeMap::setUnoccupied(int tick1, int tick2)
+{
+    const auto it1 = status.lower_bound(tick1);
+    const bool occupiedBefore = (it1 != status.end() && it1->second == Range::END);
+    const auto it2 = status.upper_bound(tick2);
+    const bool occupiedAfter = (it2 != status.end() && it2->second == Range::END);
+
+    status.erase(it1, it2);
+    if (occupiedBefore) {
+        status.insert(std::make_pair(tick1, Range::END));
+    }
+    if (occupiedAfter) {
+        status.insert(std::make_pair(tick2, Range::BEGIN));
+    }
+}
+
 //---------------------------------------------------------
 //   RangeMap::occupiedRangeEnd
 //---------------------------------------------------------
@@ -51,6 +51,7 @@ class RangeMap
 public:
     void setOccupied(int tick1, int tick2);
     void setOccupied(std::pair<int, int> range) { setOccupied(range.first, range.second); }
+    void setUnoccupied(int tick1, int tick2);
 
     int occupiedRangeEnd(int tick) const;
 
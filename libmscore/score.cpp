@@ -766,6 +766,11 @@ void Score::setPlaylistDirty()
     masterScore()->setPlaylistDirty();
 }
 
+void Score::setPlaylistDirty(const Fraction& tick1, const Fraction& tick2)
+{
+    masterScore()->setPlaylistDirty(tick1, tick2);
+}
+
 //---------------------------------------------------------
 //   setPlaylistDirty
 //---------------------------------------------------------
@@ -773,9 +778,58 @@ void Score::setPlaylistDirty()
 void MasterScore::setPlaylistDirty()
 {
     _playlistDirty = true;
+    _playlistStartTick = Fraction(-1, 1);
+    _playlistEndTick = Fraction(-1, 1);
+    _repeatList->setScoreChanged();
+}
+
+//---------------------------------------------------------
+//   setPlaylistDirty
+//    only playback of the range tick1 - tick2 has changed
+//---------------------------------------------------------
+
+void MasterScore::setPlaylistDirty(const Fraction& tick1, const Fraction& tick2)
+{
+    if (!_playlistDirty) {
+        _playlistDirty = true;
+        _playlistStartTick = tick1;
+        _playlistEndTick = tick2;
+    } else if (_playlistStartTick >= Fraction(0, 1)) {
+        _playlistStartTick = qMin(_playlistStartTick, tick1);
+        _playlistEndTick = qMax(_playlistEndTick, tick2);
+    }
+    // the repeat structure may have changed anyway,
+    // the sequencer checks this on re-rendering
     _repeatList->setScoreChanged();
 }
 
+//---------------------------------------------------------
+//   setPlaylistDirty
+//    mark the range touched by a command as dirty;
+//    commands without a tick range, or changing
+//    instruments or parts, invalidate the whole playlist
+//---------------------------------------------------------
+
+void MasterScore::setPlaylistDirty(const CmdState& cs)
+{
+    if (cs.layoutRange() && cs.startTick() >= Fraction(0, 1) && !cs._instrumentsChanged && !cs._excerptsChanged) {
+        setPlaylistDirty(cs.startTick(), cs.endTick());
+    } else {
+        setPlaylistDirty();
+    }
+}
+
+//---------------------------------------------------------
+//   setPlaylistClean
+//---------------------------------------------------------
+
+void MasterScore::setPlaylistClean()
+{
+    _playlistDirty = false;
+    _playlistStartTick = Fraction(-1, 1);
+    _playlistEndTick = Fraction(-1, 1);
+}
+
 //---------------------------------------------------------
 //   spell
 //---------------------------------------------------------
@@ -1423,13 +1477,13 @@ void Score::addElement(Element* element)
         }
         cmdState().layoutFlags |= LayoutFlag::FIX_PITCH_VELO;
         o->staff()->updateOttava();
-        setPlaylistDirty();
+        setPlaylistDirty(o->tick(), o->tick2());
     }
     break;
 
     case ElementType::DYNAMIC:
         cmdState().layoutFlags |= LayoutFlag::FIX_PITCH_VELO;
-        setPlaylistDirty();
+        setPlaylistDirty(element->tick(), endTick());
         break;
 
     case ElementType::TEMPO_TEXT:
@@ -1458,7 +1512,9 @@ void Score::addElement(Element* element)
     break;
 
     case ElementType::CHORD:
-        setPlaylistDirty();
+        for (Note* n : toChord(element)->notes()) {
+            n->setPlaylistDirty();
+        }
         // create playlist does not work here bc. tremolos may not be complete
         // createPlayEvents(toChord(element));
         break;
@@ -1589,13 +1645,13 @@ void Score::removeElement(Element* element)
         removeSpanner(o);
         o->staff()->updateOttava();
         cmdState().layoutFlags |= LayoutFlag::FIX_PITCH_VELO;
-        setPlaylistDirty();
+        setPlaylistDirty(o->tick(), o->tick2());
     }
     break;
 
     case ElementType::DYNAMIC:
         cmdState().layoutFlags |= LayoutFlag::FIX_PITCH_VELO;
-        setPlaylistDirty();
+        setPlaylistDirty(element->tick(), endTick());
         break;
 
     case ElementType::CHORD:
@@ -1608,6 +1664,11 @@ void Score::removeElement(Element* element)
         for (Lyrics* lyr : cr->lyrics()) {
             lyr->removeFromScore();
         }
+        if (cr->isChord()) {
+            for (Note* n : toChord(cr)->notes()) {
+                n->setPlaylistDirty();
+            }
+        }
         // TODO: check for tuplet?
     }
     break;
@@ -1989,6 +2050,35 @@ QString Score::metaTag(const QString& s) const
 void Score::setMetaTag(const QString& tag, const QString& val)
 {
     _metaTags.insert(tag, val);
+    invalidateThumbnail();
+}
+
+//---------------------------------------------------------
+//   setMetaTags
+//---------------------------------------------------------
+
+void Score::setMetaTags(const QMap<QString,QString>& t)
+{
+    _metaTags = t;
+    invalidateThumbnail();
+}
+
+//---------------------------------------------------------
+//   invalidateThumbnail
+//    headers and footers are expanded from the meta tags at
+//    paint time; part scores fall back to the tags of the
+//    master score
+//---------------------------------------------------------
+
+void Score::invalidateThumbnail()
+{
+    if (isMaster()) {
+        for (Score* s : scoreList()) {
+            s->_thumbnail = QImage();
+        }
+    } else {
+        _thumbnail = QImage();
+    }
 }
 
 //---------------------------------------------------------
@@ -1996,6 +2086,20 @@ void Score::setMetaTag(const QString& tag, const QString& val)
 //---------------------------------------------------------
 
 void MasterScore::addExcerpt(Excerpt* ex)
+{
+    if (!ex->isDeferred()) {
+        initExcerpt(ex);
+    }
+    excerpts().append(ex);
+    setExcerptsChanged(true);
+}
+
+//---------------------------------------------------------
+//   initExcerpt
+//    set parts and tracks of ex from its part score
+//---------------------------------------------------------
+
+void MasterScore::initExcerpt(Excerpt* ex)
 {
     Score* score = ex->partScore();
 
@@ -2031,8 +2135,30 @@ void MasterScore::addExcerpt(Excerpt* ex)
         }
         ex->setTracks(tracks);
     }
-    excerpts().append(ex);
-    setExcerptsChanged(true);
+}
+
+//---------------------------------------------------------
+//   loadDeferredExcerpts
+//    build all part scores whose loading was deferred
+//---------------------------------------------------------
+
+void MasterScore::loadDeferredExcerpts()
+{
+    for (Excerpt* ex : excerpts()) {
+        ex->partScore();
+    }
+}
+
+//---------------------------------------------------------
+//   doPendingPartsLayout
+//    lay out all part scores whose layout was deferred
+//---------------------------------------------------------
+
+void MasterScore::doPendingPartsLayout()
+{
+    for (Score* s : scoreList()) {
+        s->doPendingLayout();
+    }
 }
 
 //---------------------------------------------------------
@@ -3786,7 +3912,7 @@ QList<Score*> Score::scoreList()
     Score* root = masterScore();
     scores.append(root);
     for (const Excerpt* ex : root->excerpts()) {
-        if (ex->partScore()) {
+        if (!ex->isDeferred() && ex->partScore()) {
             scores.append(ex->partScore());
         }
     }
@@ -297,6 +297,7 @@ public:
     bool _instrumentsChanged  { false };
 
     void reset();
+    void restoreLayoutRange(const CmdState&);
     UpdateMode updateMode() const { return _updateMode; }
     void setUpdateMode(UpdateMode m);
     void _setUpdateMode(UpdateMode m);
@@ -457,6 +458,10 @@ private:
 
     UpdateState _updateState;
 
+    bool _layoutPending { false };        ///< layout of the range below is deferred
+    Fraction _pendingStartTick;
+    Fraction _pendingEndTick;
+
     MeasureBaseList _measures;            // here are the notes
     QList<Part*> _parts;
     QList<Staff*> _staves;
@@ -506,6 +511,7 @@ private:
 
     qreal _noteHeadWidth { 0.0 };         // cached value
     QString accInfo;                      ///< information used by the screen-reader
+    QImage _thumbnail;                    ///< first page, kept until it is laid out or its meta tags change
 
     //------------------
 
@@ -705,6 +711,8 @@ public:
     void undoChangeClef(Staff* ostaff, Element*, ClefType st, bool forInstrumentChange = false);
     bool undoPropertyChanged(Element* e, Pid t, const QVariant& st, PropertyFlags ps = PropertyFlags::NOSTYLE);
     void undoPropertyChanged(ScoreElement*, Pid, const QVariant& v, PropertyFlags ps = PropertyFlags::NOSTYLE);
+    void undoChangeProperties(const std::vector<Element*>&, Pid, const QVariant&);
+    void undoChangeProperties(const std::vector<Element*>&, Pid, const QVariant&, PropertyFlags);
     inline virtual UndoStack* undoStack() const;
     void undo(UndoCommand*, EditData* = 0) const;
     void undoRemoveMeasures(Measure*, Measure*);
@@ -896,6 +904,7 @@ public:
     bool autosaveDirty() const { return _autosaveDirty; }
     virtual bool playlistDirty() const;
     virtual void setPlaylistDirty();
+    virtual void setPlaylistDirty(const Fraction& tick1, const Fraction& tick2);
 
     void spell();
     void spell(int startStaff, int endStaff, Segment* startSegment, Segment* endSegment);
@@ -931,19 +940,19 @@ public:
     bool     styleB(Sid idx) const
     {
         Q_ASSERT(!strcmp(MStyle::valueType(idx),"bool"));
-        return style().value(idx).toBool();
+        return style().bvalue(idx);
     }
 
     qreal    styleD(Sid idx) const
     {
         Q_ASSERT(!strcmp(MStyle::valueType(idx),"double"));
-        return style().value(idx).toDouble();
+        return style().dvalue(idx);
     }
 
     int      styleI(Sid idx) const
     {
         Q_ASSERT(!strcmp(MStyle::valueType(idx),"int"));
-        return style().value(idx).toInt();
+        return style().ivalue(idx);
     }
 
     void setStyleValue(Sid sid, QVariant value) { style().set(sid, value); }
@@ -1102,6 +1111,10 @@ public:
 
     void doLayout();
     void doLayoutRange(const Fraction&, const Fraction&);
+    void addPendingLayout(const Fraction&, const Fraction&);
+    bool layoutPending() const { return _layoutPending; }
+    void doPendingLayout();
+    bool isDisplayed() const;
     void layoutLinear(bool layoutAll, LayoutContext& lc);
 
     void layoutChords1(Segment* segment, int staffIdx);
@@ -1120,7 +1133,7 @@ public:
 
     const QMap<QString, QString>& metaTags() const { return _metaTags; }
     QMap<QString, QString>& metaTags() { return _metaTags; }
-    void setMetaTags(const QMap<QString,QString>& t) { _metaTags = t; }
+    void setMetaTags(const QMap<QString,QString>& t);
 
     //@ returns as a string the metatag named 'tag'
     QString metaTag(const QString& tag) const;
@@ -1243,6 +1256,7 @@ public:
     QString accessibleInfo() const { return accInfo; }
 
     QImage createThumbnail();
+    void invalidateThumbnail();
     QString createRehearsalMarkText(RehearsalMark* current) const;
     QString nextRehearsalMarkText(RehearsalMark* previous, RehearsalMark* current) const;
 
@@ -1313,6 +1327,8 @@ class MasterScore : public Score
     RepeatList* _repeatList;
     bool _expandRepeats     { MScore::playRepeats };
     bool _playlistDirty     { true };
+    Fraction _playlistStartTick { -1, 1 };    // changed range of a dirty playlist,
+    Fraction _playlistEndTick   { -1, 1 };    // -1: the whole playlist is dirty
     QList<Excerpt*> _excerpts;
     std::vector<PartChannelSettingsLink> _playbackSettingsLinks;
     Score* _playbackScore = nullptr;
@@ -1369,7 +1385,11 @@ public:
 
     virtual bool playlistDirty() const override { return _playlistDirty; }
     virtual void setPlaylistDirty() override;
-    void setPlaylistClean() { _playlistDirty = false; }
+    virtual void setPlaylistDirty(const Fraction& tick1, const Fraction& tick2) override;
+    void setPlaylistDirty(const CmdState&);
+    void setPlaylistClean();
+    Fraction playlistStartTick() const { return _playlistStartTick; }
+    Fraction playlistEndTick() const { return _playlistEndTick; }
 
     void setExpandRepeats(bool expandRepeats);
     void updateRepeatListTempo();
@@ -1409,6 +1429,7 @@ public:
 
     bool saveFile(bool generateBackup = true);
     FileError read1(XmlReader&, bool ignoreVersionError);
+    FileError readMscx(const QByteArray&, bool ignoreVersionError);
     FileError loadCompressedMsc(QIODevice*, bool ignoreVersionError);
     FileError loadMsc(QString name, bool ignoreVersionError);
     FileError loadMsc(QString name, QIODevice*, bool ignoreVersionError);
@@ -1436,6 +1457,7 @@ public:
     int midiPort(int idx) const { return _midiMapping[idx].port(); }
     int midiChannel(int idx) const { return _midiMapping[idx].channel(); }
     void rebuildMidiMapping();
+    void rebuildExcerptMidiMapping(Score* partScore);
     void checkMidiMapping();
     bool exportMidiMapping() { return !isSimpleMidiMaping; }
     int getNextFreeMidiMapping(int p = -1, int ch = -1);
@@ -1451,7 +1473,10 @@ public:
     void setPos(POS pos, Fraction tick);
 
     void addExcerpt(Excerpt*);
+    void initExcerpt(Excerpt*);
     void removeExcerpt(Excerpt*);
+    void loadDeferredExcerpts();
+    void doPendingPartsLayout();
     void deleteExcerpt(Excerpt*);
 
     void setPlaybackScore(Score*);
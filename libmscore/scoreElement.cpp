@@ -413,7 +413,7 @@ void ScoreElement::readProperty(XmlReader& e, Pid id)
 
 bool ScoreElement::readProperty(const QStringRef& s, XmlReader& e, Pid id)
 {
-    if (s == propertyName(id)) {
+    if (s == QLatin1String(propertyName(id))) {
         readProperty(e, id);
         return true;
     }
@@ -526,6 +526,8 @@ QString ScoreElement::propertyUserValue(Pid id) const
 
 bool ScoreElement::readStyledProperty(XmlReader& e, const QStringRef& tag)
 {
+    // compare names: some tags like "size" or "subtype" are shared by
+    // several properties, the tag id only maps to the first of them
     for (const StyledProperty& spp : *styledProperties()) {
         if (readProperty(tag, e, spp.pid)) {
             return true;
@@ -0,0 +1,191 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  Copyright (C) 2020 MuseScore BVBA
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2
+//  as published by the Free Software Foundation and appearing in
+//  the file LICENCE.GPL
+//=============================================================================
+
+#include <QtCore/QCryptographicHash>
+#include <QtCore/QSaveFile>
+
+#include "scorecache.h"
+#include "mscore.h"
+#include "xml.h"
+
+namespace Ms {
+//---------------------------------------------------------
+//   TokenWriter
+//---------------------------------------------------------
+
+class TokenWriter
+{
+    XmlTokens* _tokens;
+    QHash<QString, int> _index;
+
+public:
+    TokenWriter(XmlTokens* t) : _tokens(t) {}
+
+    void putToken(char c) { _tokens->data.append(c); }
+    void putInt(int val);
+    void putString(const QStringRef& s);
+};
+
+//---------------------------------------------------------
+//   putInt
+//    write variable length integer
+//---------------------------------------------------------
+
+void TokenWriter::putInt(int val)
+{
+    quint32 v = quint32(val);
+    while (v >= 0x80) {
+        _tokens->data.append(char((v & 0x7f) | 0x80));
+        v >>= 7;
+    }
+    _tokens->data.append(char(v));
+}
+
+//---------------------------------------------------------
+//   putString
+//    strings are interned, only their index is written
+//---------------------------------------------------------
+
+void TokenWriter::putString(const QStringRef& s)
+{
+    const QString str = s.toString();
+    auto i = _index.constFind(str);
+    if (i != _index.constEnd()) {
+        putInt(i.value());
+        return;
+    }
+    int idx = _tokens->strings.size();
+    _tokens->strings.append(str);
+    _index.insert(str, idx);
+    putInt(idx);
+}
+
+//---------------------------------------------------------
+//   cachePath
+//---------------------------------------------------------
+
+QString ScoreCache::cachePath(const QString& scorePath)
+{
+    return scorePath + ".mscache";
+}
+
+//---------------------------------------------------------
+//   checksum
+//---------------------------------------------------------
+
+QByteArray ScoreCache::checksum(const QByteArray& mscx)
+{
+    return QCryptographicHash::hash(mscx, QCryptographicHash::Sha1);
+}
+
+//---------------------------------------------------------
+//   tokenize
+//    return false on xml error
+//---------------------------------------------------------
+
+bool ScoreCache::tokenize(const QByteArray& mscx, XmlTokens* tokens)
+{
+    *tokens = XmlTokens();
+    TokenWriter w(tokens);
+    QXmlStreamReader r(mscx);
+    while (!r.atEnd()) {
+        switch (r.readNext()) {
+        case QXmlStreamReader::StartElement: {
+            w.putToken(XmlTokens::START_ELEMENT);
+            w.putString(r.name());
+            const QXmlStreamAttributes attributes = r.attributes();
+            w.putInt(attributes.size());
+            for (const QXmlStreamAttribute& a : attributes) {
+                w.putString(a.name());
+                w.putString(a.value());
+            }
+        }
+        break;
+        case QXmlStreamReader::EndElement:
+            w.putToken(XmlTokens::END_ELEMENT);
+            break;
+        case QXmlStreamReader::Characters:
+            w.putToken(XmlTokens::CHARACTERS);
+            w.putString(r.text());
+            break;
+        default:                // comments, processing instructions etc. are not needed
+            break;
+        }
+    }
+    if (r.hasError()) {
+        qDebug("ScoreCache::tokenize: %s", qPrintable(r.errorString()));
+        *tokens = XmlTokens();
+        return false;
+    }
+    return true;
+}
+
+//---------------------------------------------------------
+//   read
+//    return false if there is no valid cache for the
+//    .mscx data with the given checksum
+//---------------------------------------------------------
+
+bool ScoreCache::read(const QString& path, const QByteArray& checksum, XmlTokens* tokens)
+{
+    QFile f(path);
+    if (!f.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+    QDataStream ds(&f);
+    ds.setVersion(QDataStream::Qt_5_9);
+
+    quint32 magic;
+    quint32 version;
+    qint32 mscVersion;
+    QByteArray cs;
+    ds >> magic >> version >> mscVersion >> cs;
+    if (ds.status() != QDataStream::Ok || magic != MAGIC || version != FORMAT_VERSION || mscVersion != MSCVERSION) {
+        qDebug("ScoreCache::read: <%s>: bad header", qPrintable(path));
+        return false;
+    }
+    if (cs != checksum) {
+        qDebug("ScoreCache::read: <%s> is stale", qPrintable(path));
+        return false;
+    }
+    quint16 crc;
+    ds >> tokens->strings >> tokens->data >> crc;
+    if (ds.status() != QDataStream::Ok || crc != qChecksum(tokens->data.constData(), tokens->data.size())) {
+        qDebug("ScoreCache::read: <%s> is corrupted", qPrintable(path));
+        *tokens = XmlTokens();
+        return false;
+    }
+    return true;
+}
+
+//---------------------------------------------------------
+//   write
+//---------------------------------------------------------
+
+bool ScoreCache::write(const QString& path, const QByteArray& checksum, const XmlTokens& tokens)
+{
+    QSaveFile f(path);
+    if (!f.open(QIODevice::WriteOnly)) {
+        qDebug("ScoreCache::write: cannot open <%s>", qPrintable(path));
+        return false;
+    }
+    QDataStream ds(&f);
+    ds.setVersion(QDataStream::Qt_5_9);
+    ds << MAGIC << FORMAT_VERSION << qint32(MSCVERSION) << checksum;
+    ds << tokens.strings << tokens.data << qChecksum(tokens.data.constData(), tokens.data.size());
+    if (ds.status() != QDataStream::Ok) {
+        f.cancelWriting();
+        return false;
+    }
+    return f.commit();
+}
+}
@@ -0,0 +1,40 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  Copyright (C) 2020 MuseScore BVBA
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2
+//  as published by the Free Software Foundation and appearing in
+//  the file LICENCE.GPL
+//=============================================================================
+
+#ifndef __SCORECACHE_H__
+#define __SCORECACHE_H__
+
+namespace Ms {
+struct XmlTokens;
+
+//---------------------------------------------------------
+//   ScoreCache
+//    binary sidecar file holding the tokenized .mscx data
+//    of a score, so that reopening an unchanged score does
+//    not need to parse xml; the cache is only valid for
+//    the .mscx data it was created from
+//---------------------------------------------------------
+
+class ScoreCache
+{
+public:
+    static constexpr quint32 MAGIC   = 0x4d534343;    // "MSCC"
+    static constexpr quint32 FORMAT_VERSION = 1;        // increment on format changes
+
+    static QString cachePath(const QString& scorePath);
+    static QByteArray checksum(const QByteArray& mscx);
+    static bool tokenize(const QByteArray& mscx, XmlTokens* tokens);
+    static bool read(const QString& path, const QByteArray& checksum, XmlTokens* tokens);
+    static bool write(const QString& path, const QByteArray& checksum, const XmlTokens& tokens);
+};
+}     // namespace Ms
+#endif
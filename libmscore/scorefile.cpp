@@ -50,6 +50,7 @@
 #include "sig.h"
 #include "undo.h"
 #include "imageStore.h"
+#include "scorecache.h"
 #include "audio.h"
 #include "barline.h"
 #include "thirdparty/qzip/qzipreader_p.h"
@@ -394,6 +395,7 @@ bool MasterScore::saveFile(bool generateBackup)
     if (readOnly()) {
         return false;
     }
+    doPendingPartsLayout();
     QString suffix = info.suffix();
     if (info.exists() && !info.isWritable()) {
         MScore::lastError = tr("The following file is locked: \n%1 \n\nTry saving to a different location.").arg(
@@ -549,13 +551,21 @@ bool Score::saveCompressedFile(QFileInfo& info, bool onlySelection, bool createT
 
 //---------------------------------------------------------
 //   createThumbnail
+//    the thumbnail is rendered again only after a layout
+//    touched the first page, see doLayoutRange(), or after
+//    a change of the meta tags used by headers and footers
 //---------------------------------------------------------
 
 QImage Score::createThumbnail()
 {
+    if (!_thumbnail.isNull()) {
+        return _thumbnail;
+    }
     LayoutMode mode = layoutMode();
-    setLayoutMode(LayoutMode::PAGE);
-    doLayout();
+    if (mode != LayoutMode::PAGE || pages().isEmpty()) {
+        setLayoutMode(LayoutMode::PAGE);
+        doLayout();
+    }
 
     Page* page = pages().at(0);
     QRectF fr  = page->abbox();
@@ -586,6 +596,7 @@ QImage Score::createThumbnail()
         setLayoutMode(mode);
         doLayout();
     }
+    _thumbnail = pm;
     return pm;
 }
 
@@ -841,6 +852,39 @@ QString readRootFile(MQZipReader* uz, QList<QString>& images)
     return rootfile;
 }
 
+//---------------------------------------------------------
+//   readMscx
+//    read score from .mscx data; with MScore::useScoreCache
+//    the tokenized data is kept in a cache file next to
+//    the score file and used as long as it matches data
+//---------------------------------------------------------
+
+Score::FileError MasterScore::readMscx(const QByteArray& data, bool ignoreVersionError)
+{
+    const QString docName = masterScore()->fileInfo()->completeBaseName();
+    if (!MScore::useScoreCache || !fileInfo()->exists()) {
+        XmlReader e(data);
+        e.setDocName(docName);
+        return read1(e, ignoreVersionError);
+    }
+
+    const QString path        = ScoreCache::cachePath(fileInfo()->absoluteFilePath());
+    const QByteArray checksum = ScoreCache::checksum(data);
+    XmlTokens tokens;
+    if (ScoreCache::read(path, checksum, &tokens)) {
+        XmlReader e(tokens, docName);
+        return read1(e, ignoreVersionError);
+    }
+
+    XmlReader e(data);
+    e.setDocName(docName);
+    FileError retval = read1(e, ignoreVersionError);
+    if (retval == FileError::FILE_NO_ERROR && ScoreCache::tokenize(data, &tokens)) {
+        ScoreCache::write(path, checksum, tokens);
+    }
+    return retval;
+}
+
 //---------------------------------------------------------
 //   loadCompressedMsc
 //    return false on error
@@ -858,11 +902,13 @@ Score::FileError MasterScore::loadCompressedMsc(QIODevice* io, bool ignoreVersio
 
     //
     // load images
+    //    only the raw data is read here, images are inflated
+    //    in worker threads while the score is parsed
     //
     if (!MScore::noImages) {
-        foreach (const QString& s, sl) {
-            QByteArray dbuf = uz.fileData(s);
-            imageStore.add(s, dbuf);
+        for (const QString& s : sl) {
+            const MQZipReader::RawData raw = uz.rawFileData(s);
+            imageStore.addPending(s, QtConcurrent::run([raw]() { return MQZipReader::uncompress(raw); }));
         }
     }
 
@@ -876,10 +922,7 @@ Score::FileError MasterScore::loadCompressedMsc(QIODevice* io, bool ignoreVersio
             }
         }
     }
-    XmlReader e(dbuf);
-    e.setDocName(masterScore()->fileInfo()->completeBaseName());
-
-    FileError retval = read1(e, ignoreVersionError);
+    FileError retval = readMscx(dbuf, ignoreVersionError);
 
 #ifdef OMR
     //
@@ -932,6 +975,8 @@ Score::FileError MasterScore::loadMsc(QString name, QIODevice* io, bool ignoreVe
 
     if (name.endsWith(".mscz") || name.endsWith(".mscz,")) {
         return loadCompressedMsc(io, ignoreVersionError);
+    } else if (MScore::useScoreCache) {
+        return readMscx(io->readAll(), ignoreVersionError);
     } else {
         XmlReader r(io);
         return read1(r, ignoreVersionError);
@@ -1074,9 +1119,9 @@ QByteArray MasterScore::readCompressedToBuffer()
     //
     // load images
     //
-    foreach (const QString& s, images) {
-        QByteArray dbuf = uz.fileData(s);
-        imageStore.add(s, dbuf);
+    for (const QString& s : images) {
+        const MQZipReader::RawData raw = uz.rawFileData(s);
+        imageStore.addPending(s, QtConcurrent::run([raw]() { return MQZipReader::uncompress(raw); }));
     }
 
     if (rootfile.isEmpty()) {
@@ -24,6 +24,7 @@
 #include "tuplet.h"
 #include "layout.h"
 #include "property.h"
+#include "namehash.h"
 #include "read206.h"
 #include "undo.h"
 
@@ -2502,18 +2503,34 @@ const char* MStyle::valueName(const Sid i)
     return styleTypes[int(i)].name();
 }
 
+//---------------------------------------------------------
+//   styleIndex
+//    hash table of the style names, built on first use
+//---------------------------------------------------------
+
+static NameIndex styleIndex()
+{
+    NameIndex index(int(Sid::STYLES));
+    for (const StyleType& st : styleTypes) {
+        index.insert(st.name(), st.idx());
+    }
+    return index;
+}
+
 //---------------------------------------------------------
 //   styleIdx
 //---------------------------------------------------------
 
 Sid MStyle::styleIdx(const QString& name)
 {
-    for (StyleType st : styleTypes) {
-        if (st.name() == name) {
-            return st.styleIdx();
-        }
-    }
-    return Sid::NOSTYLE;
+    return styleIdx(QStringRef(&name));
+}
+
+Sid MStyle::styleIdx(const QStringRef& name)
+{
+    static const NameIndex index = styleIndex();
+    const int idx = index.value(name);
+    return idx == -1 ? Sid::NOSTYLE : Sid(idx);
 }
 
 //---------------------------------------------------------
@@ -2526,6 +2543,7 @@ MStyle::MStyle()
     for (const StyleType& t : styleTypes) {
         _values[t.idx()] = t.defaultValue();
     }
+    precomputeValues();
 }
 
 //---------------------------------------------------------
@@ -2536,9 +2554,28 @@ void MStyle::precomputeValues()
 {
     qreal _spatium = value(Sid::spatium).toDouble();
     for (const StyleType& t : styleTypes) {
-        if (!strcmp(t.valueType(), "Ms::Spatium")) {
-            _precomputedValues[t.idx()] = _values[t.idx()].value<Spatium>().val() * _spatium;
-        }
+        precomputeValue(t.idx(), _spatium);
+    }
+}
+
+//---------------------------------------------------------
+//   precomputeValue
+//    keep unboxed copies of numeric values, layout reads
+//    them without QVariant conversion
+//---------------------------------------------------------
+
+void MStyle::precomputeValue(int idx, qreal spatium)
+{
+    const char* type = styleTypes[idx].valueType();
+    const QVariant& v = _values[idx];
+    if (!strcmp(type, "Ms::Spatium")) {
+        _precomputedValues[idx] = v.value<Spatium>().val() * spatium;
+    } else if (!strcmp(type, "double")) {
+        _precomputedValues[idx] = v.toDouble();
+    } else if (!strcmp(type, "bool")) {
+        _intValues[idx] = v.toBool();
+    } else if (!strcmp(type, "int")) {
+        _intValues[idx] = v.toInt();
     }
 }
 
@@ -2606,10 +2643,7 @@ void MStyle::set(const Sid t, const QVariant& val)
     if (t == Sid::spatium) {
         precomputeValues();
     } else {
-        if (!strcmp(styleTypes[idx].valueType(), "Ms::Spatium")) {
-            qreal _spatium = value(Sid::spatium).toDouble();
-            _precomputedValues[idx] = _values[idx].value<Spatium>().val() * _spatium;
-        }
+        precomputeValue(idx, value(Sid::spatium).toDouble());
     }
 }
 
@@ -2621,73 +2655,71 @@ bool MStyle::readProperties(XmlReader& e)
 {
     const QStringRef& tag(e.name());
 
-    for (const StyleType& t : styleTypes) {
-        Sid idx = t.styleIdx();
-        if (t.name() == tag) {
-            const char* type = t.valueType();
-            if (!strcmp("Ms::Spatium", type)) {
-                set(idx, Spatium(e.readElementText().toDouble()));
-            } else if (!strcmp("double", type)) {
-                set(idx, QVariant(e.readElementText().toDouble()));
-            } else if (!strcmp("bool", type)) {
-                set(idx, QVariant(bool(e.readElementText().toInt())));
-            } else if (!strcmp("int", type)) {
-                set(idx, QVariant(e.readElementText().toInt()));
-            } else if (!strcmp("Ms::Direction", type)) {
-                set(idx, QVariant::fromValue(Direction(e.readElementText().toInt())));
-            } else if (!strcmp("QString", type)) {
-                set(idx, QVariant(e.readElementText()));
-            } else if (!strcmp("Ms::Align", type)) {
-                QStringList sl = e.readElementText().split(',');
-                if (sl.size() != 2) {
-                    qDebug("bad align text <%s>", qPrintable(e.readElementText()));
-                    return true;
-                }
-                Align align = Align::LEFT;
-                if (sl[0] == "center") {
-                    align = align | Align::HCENTER;
-                } else if (sl[0] == "right") {
-                    align = align | Align::RIGHT;
-                } else if (sl[0] == "left") {
-                } else {
-                    qDebug("bad align text <%s>", qPrintable(sl[0]));
-                    return true;
-                }
-                if (sl[1] == "center") {
-                    align = align | Align::VCENTER;
-                } else if (sl[1] == "bottom") {
-                    align = align | Align::BOTTOM;
-                } else if (sl[1] == "baseline") {
-                    align = align | Align::BASELINE;
-                } else if (sl[1] == "top") {
-                } else {
-                    qDebug("bad align text <%s>", qPrintable(sl[1]));
-                    return true;
-                }
-                set(idx, QVariant::fromValue(align));
-            } else if (!strcmp("QPointF", type)) {
-                qreal x = e.doubleAttribute("x", 0.0);
-                qreal y = e.doubleAttribute("y", 0.0);
-                set(idx, QPointF(x, y));
-                e.readElementText();
-            } else if (!strcmp("QSizeF", type)) {
-                qreal x = e.doubleAttribute("w", 0.0);
-                qreal y = e.doubleAttribute("h", 0.0);
-                set(idx, QSizeF(x, y));
-                e.readElementText();
-            } else if (!strcmp("QColor", type)) {
-                QColor c;
-                c.setRed(e.intAttribute("r"));
-                c.setGreen(e.intAttribute("g"));
-                c.setBlue(e.intAttribute("b"));
-                c.setAlpha(e.intAttribute("a", 255));
-                set(idx, c);
-                e.readElementText();
+    const Sid idx = styleIdx(tag);
+    if (idx != Sid::NOSTYLE) {
+        const char* type = styleTypes[int(idx)].valueType();
+        if (!strcmp("Ms::Spatium", type)) {
+            set(idx, Spatium(e.readElementText().toDouble()));
+        } else if (!strcmp("double", type)) {
+            set(idx, QVariant(e.readElementText().toDouble()));
+        } else if (!strcmp("bool", type)) {
+            set(idx, QVariant(bool(e.readElementText().toInt())));
+        } else if (!strcmp("int", type)) {
+            set(idx, QVariant(e.readElementText().toInt()));
+        } else if (!strcmp("Ms::Direction", type)) {
+            set(idx, QVariant::fromValue(Direction(e.readElementText().toInt())));
+        } else if (!strcmp("QString", type)) {
+            set(idx, QVariant(e.readElementText()));
+        } else if (!strcmp("Ms::Align", type)) {
+            QStringList sl = e.readElementText().split(',');
+            if (sl.size() != 2) {
+                qDebug("bad align text <%s>", qPrintable(e.readElementText()));
+                return true;
+            }
+            Align align = Align::LEFT;
+            if (sl[0] == "center") {
+                align = align | Align::HCENTER;
+            } else if (sl[0] == "right") {
+                align = align | Align::RIGHT;
+            } else if (sl[0] == "left") {
             } else {
-                qFatal("unhandled type %s", type);
+                qDebug("bad align text <%s>", qPrintable(sl[0]));
+                return true;
             }
-            return true;
+            if (sl[1] == "center") {
+                align = align | Align::VCENTER;
+            } else if (sl[1] == "bottom") {
+                align = align | Align::BOTTOM;
+            } else if (sl[1] == "baseline") {
+                align = align | Align::BASELINE;
+            } else if (sl[1] == "top") {
+            } else {
+                qDebug("bad align text <%s>", qPrintable(sl[1]));
+                return true;
+            }
+            set(idx, QVariant::fromValue(align));
+        } else if (!strcmp("QPointF", type)) {
+            qreal x = e.doubleAttribute("x", 0.0);
+            qreal y = e.doubleAttribute("y", 0.0);
+            set(idx, QPointF(x, y));
+            e.readElementText();
+        } else if (!strcmp("QSizeF", type)) {
+            qreal x = e.doubleAttribute("w", 0.0);
+            qreal y = e.doubleAttribute("h", 0.0);
+            set(idx, QSizeF(x, y));
+            e.readElementText();
+        } else if (!strcmp("QColor", type)) {
+            QColor c;
+            c.setRed(e.intAttribute("r"));
+            c.setGreen(e.intAttribute("g"));
+            c.setBlue(e.intAttribute("b"));
+            c.setAlpha(e.intAttribute("a", 255));
+            set(idx, c);
+            e.readElementText();
+        } else {
+            qFatal("unhandled type %s", type);
         }
+        return true;
     }
     if (readStyleValCompat(e)) {
         return true;
@@ -1322,7 +1322,8 @@ END_QT_REGISTERED_ENUM(Sid)
 class MStyle
 {
     std::array<QVariant, int(Sid::STYLES)> _values;
-    std::array<qreal, int(Sid::STYLES)> _precomputedValues;
+    std::array<qreal, int(Sid::STYLES)> _precomputedValues;   // spatium values in raster units and doubles
+    std::array<int, int(Sid::STYLES)> _intValues;             // bools and ints
 
     ChordList _chordList;
     bool _customChordList;          // if true, chordlist will be saved as part of score
@@ -1331,8 +1332,12 @@ public:
     MStyle();
 
     void precomputeValues();
+    void precomputeValue(int idx, qreal spatium);
     const QVariant& value(Sid idx) const;
     qreal pvalue(Sid idx) const { return _precomputedValues[int(idx)]; }
+    qreal dvalue(Sid idx) const { return _precomputedValues[int(idx)]; }
+    bool bvalue(Sid idx) const { return _intValues[int(idx)]; }
+    int ivalue(Sid idx) const { return _intValues[int(idx)]; }
     void set(Sid idx, const QVariant& v);
 
     bool isDefault(Sid idx) const;
@@ -1355,6 +1360,7 @@ public:
     static const char* valueType(const Sid);
     static const char* valueName(const Sid);
     static Sid styleIdx(const QString& name);
+    static Sid styleIdx(const QStringRef& name);
 };
 
 //---------------------------------------------------------
@@ -16,6 +16,7 @@
 #include "score.h"
 #include "xml.h"
 #include "mscore.h"
+#include "textmetrics.h"
 
 #include FT_GLYPH_H
 #include FT_IMAGE_H
@@ -31,6 +32,10 @@ namespace Ms {
 
 static const int FALLBACK_FONT = 0;       // Bravura
 
+// protects the glyph caches and FreeType, ScoreFont::draw()
+// can be called from several threads painting into images
+static QMutex glyphMutex;
+
 QVector<ScoreFont> ScoreFont::_scoreFonts {
     ScoreFont("Bravura",    "Bravura",     ":/fonts/bravura/",   "Bravura.otf"),
     ScoreFont("Emmentaler", "MScore",      ":/fonts/mscore/",    "mscore.ttf"),
@@ -5668,8 +5673,39 @@ SymId Sym::userName2id(const QString& s)
 
 bool GlyphKey::operator==(const GlyphKey& k) const
 {
-    return (face == k.face) && (id == k.id)
-           && (magX == k.magX) && (magY == k.magY) && (worldScale == k.worldScale) && (color == k.color);
+    return (face == k.face) && (id == k.id) && (scaleX == k.scaleX) && (scaleY == k.scaleY);
+}
+
+//---------------------------------------------------------
+//   GlyphPixmap::image
+//    tint the alpha mask with color; the result is kept
+//    for the most recently used colors
+//---------------------------------------------------------
+
+const QImage& GlyphPixmap::image(QRgb color)
+{
+    for (auto& t : tinted) {
+        if (t.first == color) {
+            return t.second;
+        }
+    }
+    QImage img(mask.size(), QImage::Format_ARGB32_Premultiplied);
+    const int r = qRed(color);
+    const int g = qGreen(color);
+    const int b = qBlue(color);
+    for (int y = 0; y < mask.height(); ++y) {
+        const uchar* src = mask.constScanLine(y);
+        QRgb* dst        = reinterpret_cast<QRgb*>(img.scanLine(y));
+        for (int x = 0; x < mask.width(); ++x) {
+            *dst++ = qPremultiply(qRgba(r, g, b, *src++));
+        }
+    }
+    img.setDevicePixelRatio(scale);
+    if (tinted.size() >= MAX_TINTS) {
+        tinted.erase(tinted.begin());
+    }
+    tinted.emplace_back(color, img);
+    return tinted.back().second;
 }
 
 //---------------------------------------------------------
@@ -5707,19 +5743,16 @@ void ScoreFont::draw(SymId id, QPainter* painter, const QSizeF& mag, const QPoin
         }
         return;
     }
-    int rv = FT_Load_Glyph(face, sym(id).index(), FT_LOAD_DEFAULT);
-    if (rv) {
-        qDebug("load glyph id %d, failed: 0x%x", int(id), rv);
-        return;
-    }
-
     if (MScore::pdfPrinting) {
+        // only the shared font is guarded, pages are painted concurrently
+        QMutexLocker lock(&glyphMutex);
         if (font == 0) {
             QString s(_fontPath + _filename);
             if (-1 == QFontDatabase::addApplicationFont(s)) {
                 qDebug("Mscore: fatal error: cannot load internal font <%s>", qPrintable(s));
                 return;
             }
+            TextMetrics::clear();
             font = new QFont;
             font->setWeight(QFont::Normal);
             font->setItalic(false);
@@ -5727,30 +5760,47 @@ void ScoreFont::draw(SymId id, QPainter* painter, const QSizeF& mag, const QPoin
             font->setStyleStrategy(QFont::NoFontMerging);
             font->setHintingPreference(QFont::PreferVerticalHinting);
         }
+        QFont f = *font;
+        lock.unlock();
+
         qreal size = 20.0 * MScore::pixelRatio;
-        font->setPointSize(size);
+        f.setPointSize(size);
         QSizeF imag = QSizeF(1.0 / mag.width(), 1.0 / mag.height());
         painter->scale(mag.width(), mag.height());
-        painter->setFont(*font);
+        painter->setFont(f);
         painter->drawText(QPointF(pos.x() * imag.width(), pos.y() * imag.height()), toString(id));
         painter->scale(imag.width(), imag.height());
         return;
     }
 
-    QColor color(painter->pen().color());
-
     int pr           = painter->device()->devicePixelRatio();
     qreal pixelRatio = qreal(pr > 0 ? pr : 1);
     worldScale      *= pixelRatio;
 //      if (worldScale < 1.0)
 //            worldScale = 1.0;
+    // render at the nearest 1/32 octave so continuous zooming
+    // reuses the cached glyph; the pixmap device pixel ratio
+    // absorbs the remaining difference (at most 1.1%)
+    if (worldScale > 0.0) {
+        worldScale = std::exp2(std::round(std::log2(worldScale) * 32.0) / 32.0);
+    }
     int scale16X      = lrint(worldScale * 6553.6 * mag.width() * DPI_F);
     int scale16Y      = lrint(worldScale * 6553.6 * mag.height() * DPI_F);
 
-    GlyphKey gk(face, id, mag.width(), mag.height(), worldScale, color);
+    QMutexLocker lock(&glyphMutex);
+    GlyphKey gk(face, id, scale16X, scale16Y);
     GlyphPixmap* pm = cache->object(gk);
+    bool cached     = true;
 
-    if (!pm) {
+    if (pm) {
+        ++_cacheHits;
+    } else {
+        ++_cacheMisses;
+        int rv = FT_Load_Glyph(face, sym(id).index(), FT_LOAD_DEFAULT);
+        if (rv) {
+            qDebug("load glyph id %d, failed: 0x%x", int(id), rv);
+            return;
+        }
         FT_Matrix matrix {
             scale16X, 0,
             0,       scale16Y
@@ -5770,30 +5820,34 @@ void ScoreFont::draw(SymId id, QPainter* painter, const QSizeF& mag, const QPoin
 
         if (bm->width == 0 || bm->rows == 0) {
             qDebug("zero glyph, id %d", int(id));
+            FT_Done_Glyph(glyph);
             return;
         }
-        QImage img(QSize(bm->width, bm->rows), QImage::Format_ARGB32);
-        img.fill(Qt::transparent);
-
+        pm = new GlyphPixmap;
+        pm->mask = QImage(QSize(bm->width, bm->rows), QImage::Format_Alpha8);
         for (unsigned y = 0; y < bm->rows; ++y) {
-            unsigned* dst      = (unsigned*)img.scanLine(y);
-            unsigned char* src = (unsigned char*)(bm->buffer) + bm->pitch * y;
-            for (unsigned x = 0; x < bm->width; ++x) {
-                unsigned val = *src++;
-                color.setAlpha(val);
-                *dst++ = color.rgba();
-            }
+            memcpy(pm->mask.scanLine(y), bm->buffer + bm->pitch * y, bm->width);
         }
-        pm = new GlyphPixmap;
-        pm->pm = QPixmap::fromImage(img, Qt::NoFormatConversion);
-        pm->pm.setDevicePixelRatio(worldScale);
+        pm->scale  = worldScale;
         pm->offset = QPointF(qreal(gb->left), -qreal(gb->top)) / worldScale;
-        if (!cache->insert(gk, pm)) {
-            qDebug("cannot cache glyph");
-        }
         FT_Done_Glyph(glyph);
+        // cost is the size of the mask plus all tinted pixmaps
+        // it may keep; QCache deletes a glyph too large for it
+        const int cost = int(bm->width * bm->rows * (1 + 4 * GlyphPixmap::MAX_TINTS));
+        if (cost > cache->maxCost()) {
+            qDebug("glyph too large to cache, id %d", int(id));
+            cached = false;
+        } else {
+            cache->insert(gk, pm, cost);
+        }
+    }
+    const QPointF offset = pm->offset;
+    const QImage img     = pm->image(painter->pen().color().rgb());
+    if (!cached) {
+        delete pm;
     }
-    painter->drawPixmap(pos + pm->offset, pm->pm);
+    lock.unlock();
+    painter->drawImage(pos + offset, img);
 }
 
 void ScoreFont::draw(SymId id, QPainter* painter, qreal mag, const QPointF& pos, int n) const
@@ -5952,7 +6006,7 @@ void ScoreFont::load()
         qDebug("freetype: cannot create face <%s>: %d", qPrintable(facePath), rval);
         return;
     }
-    cache = new QCache<GlyphKey, GlyphPixmap>(100);
+    cache = new QCache<GlyphKey, GlyphPixmap>(32 * 1024 * 1024);      // cost is in bytes
 
     qreal pixelSize = 200.0;
     FT_Set_Pixel_Sizes(face, 0, int(pixelSize + .5));
@@ -6271,6 +6325,7 @@ ScoreFont* ScoreFont::fontFactory(QString s)
         return fallbackFont();
     }
 
+    QMutexLocker lock(&glyphMutex);
     if (!f->face) {
         f->load();
     }
@@ -6284,6 +6339,7 @@ ScoreFont* ScoreFont::fontFactory(QString s)
 ScoreFont* ScoreFont::fallbackFont()
 {
     ScoreFont* f = &_scoreFonts[FALLBACK_FONT];
+    QMutexLocker lock(&glyphMutex);
     if (!f->face) {
         f->load();
     }
@@ -2733,30 +2733,43 @@ public:
 
 //---------------------------------------------------------
 //   GlyphKey
+//    the FreeType scale of a cached glyph is quantized
+//    (see ScoreFont::draw()), so nearby zoom levels share
+//    the same entry
 //---------------------------------------------------------
 
 struct GlyphKey {
     FT_Face face;
     SymId id;
-    qreal magX;
-    qreal magY;
-    qreal worldScale;
-    QColor color;
+    int scaleX;
+    int scaleY;
 
 public:
-    GlyphKey(FT_Face _f, SymId _id, float mx, float my, float s, QColor c)
-        : face(_f), id(_id), magX(mx), magY(my), worldScale(s), color(c) {}
+    GlyphKey(FT_Face _f, SymId _id, int sx, int sy)
+        : face(_f), id(_id), scaleX(sx), scaleY(sy) {}
     bool operator==(const GlyphKey&) const;
 };
 
+//---------------------------------------------------------
+//   GlyphPixmap
+//    alpha mask of a rendered glyph and the images
+//    tinted from it for the last few colors used
+//---------------------------------------------------------
+
 struct GlyphPixmap {
-    QPixmap pm;
+    static const size_t MAX_TINTS = 4;
+
+    QImage mask;                    // Format_Alpha8
     QPointF offset;
+    qreal scale;
+    std::vector<std::pair<QRgb, QImage> > tinted;
+
+    const QImage& image(QRgb color);
 };
 
 inline uint qHash(const GlyphKey& k)
 {
-    return (int(k.id) << 16) + (int(k.magX * 100) << 8) + k.magY * 100;
+    return (uint(k.id) << 16) ^ (uint(k.scaleX) * 31u) ^ uint(k.scaleY);
 }
 
 //---------------------------------------------------------
@@ -2773,6 +2786,8 @@ class ScoreFont
     QString _filename;
     QByteArray fontImage;
     QCache<GlyphKey, GlyphPixmap>* cache { 0 };
+    mutable int _cacheHits { 0 };
+    mutable int _cacheMisses { 0 };
     std::list<std::pair<Sid, QVariant> > _engravingDefaults;
     double _textEnclosureThickness = 0;
     mutable QFont* font { 0 };
@@ -2819,6 +2834,10 @@ public:
     void draw(const std::vector<SymId>&, QPainter*, qreal mag,         const QPointF& pos, qreal scale) const;
     void draw(const std::vector<SymId>&, QPainter*, const QSizeF& mag, const QPointF& pos, qreal scale) const;
 
+    int cacheHits() const { return _cacheHits; }
+    int cacheMisses() const { return _cacheMisses; }
+    void resetCacheStatistics() { _cacheHits = 0; _cacheMisses = 0; }
+
     qreal height(SymId id, qreal mag) const { return bbox(id, mag).height(); }
     qreal width(SymId id, qreal mag) const { return bbox(id, mag).width(); }
     qreal advance(SymId id, qreal mag) const;
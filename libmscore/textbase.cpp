@@ -21,6 +21,7 @@
 #include "box.h"
 #include "page.h"
 #include "textframe.h"
+#include "textmetrics.h"
 #include "sym.h"
 #include "xml.h"
 #include "undo.h"
@@ -616,29 +617,7 @@ QFont TextFragment::font(const TextBase* t) const
 
         // check if all symbols are available
         font.setFamily(family);
-        QFontMetricsF fm(font);
-
-        bool fail = false;
-        for (int i = 0; i < text.size(); ++i) {
-            QChar c = text[i];
-            if (c.isHighSurrogate()) {
-                if (i + 1 == text.size()) {
-                    qFatal("bad string");
-                }
-                QChar c2 = text[i + 1];
-                ++i;
-                uint v = QChar::surrogateToUcs4(c, c2);
-                if (!fm.inFontUcs4(v)) {
-                    fail = true;
-                    break;
-                }
-            } else {
-                if (!fm.inFont(c)) {
-                    fail = true;
-                    break;
-                }
-            }
-        }
+        bool fail = !TextMetrics::inFont(font, text);
         if (fail) {
             family = ScoreFont::fallbackTextFont();
         }
@@ -716,9 +695,9 @@ void TextBlock::layout(TextBase* t)
         for (auto fi = _fragments.begin(); fi != _fragments.end(); ++fi) {
             TextFragment& f = *fi;
             f.pos.setX(x);
-            QFontMetricsF fm(f.font(t), MScore::paintDevice());
+            const QFont font = f.font(t);
             if (f.format.valign() != VerticalAlignment::AlignNormal) {
-                qreal voffset = fm.xHeight() / subScriptSize;           // use original height
+                qreal voffset = TextMetrics::xHeight(font) / subScriptSize;           // use original height
                 if (f.format.valign() == VerticalAlignment::AlignSubScript) {
                     voffset *= subScriptOffset;
                 } else {
@@ -732,12 +711,12 @@ void TextBlock::layout(TextBase* t)
             // Optimization: don't calculate character position
             // for the next fragment if there is no next fragment
             if (fi != fiLast) {
-                const qreal w  = fm.width(f.text);
+                const qreal w  = TextMetrics::width(font, f.text);
                 x += w;
             }
 
-            _bbox   |= fm.tightBoundingRect(f.text).translated(f.pos);
-            _lineSpacing = qMax(_lineSpacing, fm.lineSpacing());
+            _bbox   |= TextMetrics::tightBoundingRect(font, f.text).translated(f.pos);
+            _lineSpacing = qMax(_lineSpacing, TextMetrics::lineSpacing(font));
         }
     }
     qreal rx;
@@ -1604,9 +1583,8 @@ void TextBase::layoutFrame()
 //      if (empty()) {    // or bbox.width() <= 1.0
     if (bbox().width() <= 1.0 || bbox().height() < 1.0) {      // or bbox.width() <= 1.0
         // this does not work for Harmony:
-        QFontMetricsF fm = QFontMetricsF(font(), MScore::paintDevice());
-        qreal ch = fm.ascent();
-        qreal cw = fm.width('n');
+        qreal ch = TextMetrics::ascent(font());
+        qreal cw = TextMetrics::width(font(), QString("n"));
         frame = QRectF(0.0, -ch, cw, ch);
     } else {
         frame = bbox();
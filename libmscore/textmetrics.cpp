@@ -0,0 +1,226 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  Copyright (C) 2020 MuseScore BVBA
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2
+//  as published by the Free Software Foundation and appearing in
+//  the file LICENCE.GPL
+//=============================================================================
+
+#include "textmetrics.h"
+#include "mscore.h"
+
+namespace Ms {
+//---------------------------------------------------------
+//   StringKey
+//---------------------------------------------------------
+
+struct StringKey {
+    QFont font;
+    QString text;
+    bool operator==(const StringKey& k) const { return text == k.text && font == k.font; }
+};
+
+static inline uint qHash(const StringKey& k, uint seed = 0)
+{
+    return qHash(k.font, seed) ^ qHash(k.text, seed);
+}
+
+//---------------------------------------------------------
+//   StringMetrics
+//    computed on demand, tight bounding rectangles are
+//    expensive and only needed by some callers
+//---------------------------------------------------------
+
+struct StringMetrics {
+    enum : char {
+        WIDTH = 1, BBOX = 2, TIGHT_BBOX = 4
+    };
+    char valid { 0 };
+    qreal width { 0.0 };
+    QRectF bbox;
+    QRectF tightBBox;
+};
+
+struct FontMetrics {
+    qreal ascent;
+    qreal lineSpacing;
+    qreal xHeight;
+};
+
+// text layout can run while pages are painted concurrently
+static QMutex mutex;
+static QHash<StringKey, StringMetrics> strings;
+static QHash<QFont, FontMetrics> fonts;
+static QHash<StringKey, bool> glyphsInFont;
+
+static const int MAX_ENTRIES = 50000;     // start over rather than track usage
+
+//---------------------------------------------------------
+//   stringMetrics
+//    called with mutex locked
+//---------------------------------------------------------
+
+static StringMetrics& stringMetrics(const QFont& f, const QString& s)
+{
+    if (strings.size() >= MAX_ENTRIES) {
+        strings.clear();
+    }
+    return strings[StringKey { f, s }];
+}
+
+//---------------------------------------------------------
+//   fontMetrics
+//---------------------------------------------------------
+
+static FontMetrics fontMetrics(const QFont& f)
+{
+    QMutexLocker lock(&mutex);
+    auto i = fonts.constFind(f);
+    if (i != fonts.constEnd()) {
+        return *i;
+    }
+    QFontMetricsF fm(f, MScore::paintDevice());
+    FontMetrics m { fm.ascent(), fm.lineSpacing(), fm.xHeight() };
+    if (fonts.size() >= MAX_ENTRIES) {
+        fonts.clear();
+    }
+    fonts.insert(f, m);
+    return m;
+}
+
+//---------------------------------------------------------
+//   width
+//---------------------------------------------------------
+
+qreal TextMetrics::width(const QFont& f, const QString& s)
+{
+    QMutexLocker lock(&mutex);
+    StringMetrics& m = stringMetrics(f, s);
+    if (!(m.valid & StringMetrics::WIDTH)) {
+        m.width = QFontMetricsF(f, MScore::paintDevice()).width(s);
+        m.valid |= StringMetrics::WIDTH;
+    }
+    return m.width;
+}
+
+//---------------------------------------------------------
+//   boundingRect
+//---------------------------------------------------------
+
+QRectF TextMetrics::boundingRect(const QFont& f, const QString& s)
+{
+    QMutexLocker lock(&mutex);
+    StringMetrics& m = stringMetrics(f, s);
+    if (!(m.valid & StringMetrics::BBOX)) {
+        m.bbox = QFontMetricsF(f, MScore::paintDevice()).boundingRect(s);
+        m.valid |= StringMetrics::BBOX;
+    }
+    return m.bbox;
+}
+
+//---------------------------------------------------------
+//   tightBoundingRect
+//---------------------------------------------------------
+
+QRectF TextMetrics::tightBoundingRect(const QFont& f, const QString& s)
+{
+    QMutexLocker lock(&mutex);
+    StringMetrics& m = stringMetrics(f, s);
+    if (!(m.valid & StringMetrics::TIGHT_BBOX)) {
+        m.tightBBox = QFontMetricsF(f, MScore::paintDevice()).tightBoundingRect(s);
+        m.valid |= StringMetrics::TIGHT_BBOX;
+    }
+    return m.tightBBox;
+}
+
+//---------------------------------------------------------
+//   ascent
+//---------------------------------------------------------
+
+qreal TextMetrics::ascent(const QFont& f)
+{
+    return fontMetrics(f).ascent;
+}
+
+//---------------------------------------------------------
+//   lineSpacing
+//---------------------------------------------------------
+
+qreal TextMetrics::lineSpacing(const QFont& f)
+{
+    return fontMetrics(f).lineSpacing;
+}
+
+//---------------------------------------------------------
+//   xHeight
+//---------------------------------------------------------
+
+qreal TextMetrics::xHeight(const QFont& f)
+{
+    return fontMetrics(f).xHeight;
+}
+
+//---------------------------------------------------------
+//   inFont
+//    true if the font has glyphs for all characters of s;
+//    asks the screen font like QFontMetricsF(f) does
+//---------------------------------------------------------
+
+bool TextMetrics::inFont(const QFont& f, const QString& s)
+{
+    QMutexLocker lock(&mutex);
+    const StringKey key { f, s };
+    auto i = glyphsInFont.constFind(key);
+    if (i != glyphsInFont.constEnd()) {
+        return *i;
+    }
+    QFontMetricsF fm(f);
+    bool found = true;
+    for (int k = 0; k < s.size() && found; ++k) {
+        QChar c = s[k];
+        if (c.isHighSurrogate()) {
+            if (k + 1 == s.size()) {
+                qFatal("bad string");
+            }
+            QChar c2 = s[k + 1];
+            ++k;
+            found = fm.inFontUcs4(QChar::surrogateToUcs4(c, c2));
+        } else {
+            found = fm.inFont(c);
+        }
+    }
+    if (glyphsInFont.size() >= MAX_ENTRIES) {
+        glyphsInFont.clear();
+    }
+    glyphsInFont.insert(key, found);
+    return found;
+}
+
+//---------------------------------------------------------
+//   clear
+//    needed when application fonts are added, which
+//    can change the family a font resolves to
+//---------------------------------------------------------
+
+void TextMetrics::clear()
+{
+    QMutexLocker lock(&mutex);
+    strings.clear();
+    fonts.clear();
+    glyphsInFont.clear();
+}
+
+//---------------------------------------------------------
+//   size
+//---------------------------------------------------------
+
+int TextMetrics::size()
+{
+    QMutexLocker lock(&mutex);
+    return strings.size();
+}
+}
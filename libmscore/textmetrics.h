@@ -0,0 +1,41 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  Copyright (C) 2020 MuseScore BVBA
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2
+//  as published by the Free Software Foundation and appearing in
+//  the file LICENCE.GPL
+//=============================================================================
+
+#ifndef __TEXTMETRICS_H__
+#define __TEXTMETRICS_H__
+
+namespace Ms {
+//---------------------------------------------------------
+//   TextMetrics
+//    font metrics on MScore::paintDevice(), cached by font
+//    and string for all text elements; text layout asks for
+//    the same few fonts and strings over and over
+//---------------------------------------------------------
+
+class TextMetrics
+{
+public:
+    static qreal width(const QFont&, const QString&);
+    static QRectF boundingRect(const QFont&, const QString&);
+    static QRectF tightBoundingRect(const QFont&, const QString&);
+
+    static qreal ascent(const QFont&);
+    static qreal lineSpacing(const QFont&);
+    static qreal xHeight(const QFont&);
+
+    static bool inFont(const QFont&, const QString&);
+
+    static void clear();
+    static int size();
+};
+}     // namespace Ms
+#endif
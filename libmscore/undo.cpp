@@ -185,6 +185,21 @@ void UndoCommand::appendChildren(UndoCommand* other)
     other->childList.clear();
 }
 
+//---------------------------------------------------------
+//   memorySize
+///   Approximate memory held by this command and its
+///   children, used for the undo memory limit.
+//---------------------------------------------------------
+
+size_t UndoCommand::memorySize() const
+{
+    size_t n = sizeof(UndoCommand) + childList.size() * sizeof(UndoCommand*);
+    for (const UndoCommand* c : childList) {
+        n += c->memorySize();
+    }
+    return n;
+}
+
 //---------------------------------------------------------
 //   hasFilteredChildren
 //---------------------------------------------------------
@@ -259,6 +274,9 @@ UndoStack::UndoStack()
 {
     curCmd   = 0;
     curIdx   = 0;
+    trimmed  = 0;
+    bulkEdit = 0;
+    _memoryUsed = 0;
     cleanState = 0;
     stateList.push_back(cleanState);
     nextState = 1;
@@ -316,6 +334,9 @@ void UndoStack::push(UndoCommand* cmd, EditData* ed)
 #endif
     curCmd->appendChild(cmd);
     cmd->redo(ed);
+    if (!bulkEdit || !curCmd->collectPropertyChange(cmd)) {
+        curCmd->coalesce(cmd);
+    }
 }
 
 //---------------------------------------------------------
@@ -345,6 +366,8 @@ void UndoStack::remove(int idx)
     while (list.size() > curIdx) {
         UndoCommand* cmd = list.takeLast();
         stateList.pop_back();
+        _memoryUsed -= sizeList.back();
+        sizeList.pop_back();
         cmd->cleanup(false);      // delete elements for which UndoCommand() holds ownership
         delete cmd;
 //            --curIdx;
@@ -352,6 +375,8 @@ void UndoStack::remove(int idx)
     while (list.size() > idx) {
         UndoCommand* cmd = list.takeLast();
         stateList.pop_back();
+        _memoryUsed -= sizeList.back();
+        sizeList.pop_back();
         cmd->cleanup(true);
         delete cmd;
     }
@@ -364,6 +389,9 @@ void UndoStack::remove(int idx)
 
 void UndoStack::mergeCommands(int startIdx)
 {
+    // startIdx is a getCurIdx() value; macros trimmed since then
+    // were the oldest ones, so the remaining ones are merged
+    startIdx = qMax(startIdx - trimmed, 0);
     Q_ASSERT(startIdx <= curIdx);
 
     if (startIdx >= list.size()) {
@@ -374,8 +402,14 @@ void UndoStack::mergeCommands(int startIdx)
 
     for (int idx = startIdx + 1; idx < curIdx; ++idx) {
         startMacro->append(std::move(*list[idx]));
+        _memoryUsed -= sizeList[idx];
+        sizeList[idx] = list[idx]->memorySize();
+        _memoryUsed += sizeList[idx];
     }
     remove(startIdx + 1);   // TODO: remove from startIdx to curIdx only
+    _memoryUsed -= sizeList[startIdx];
+    sizeList[startIdx] = startMacro->memorySize();
+    _memoryUsed += sizeList[startIdx];
 }
 
 //---------------------------------------------------------
@@ -425,14 +459,43 @@ void UndoStack::endMacro(bool rollback)
         while (list.size() > curIdx) {
             UndoCommand* cmd = list.takeLast();
             stateList.pop_back();
+            _memoryUsed -= sizeList.back();
+            sizeList.pop_back();
             cmd->cleanup(false);        // delete elements for which UndoCommand() holds ownership
             delete cmd;
         }
         list.append(curCmd);
         stateList.push_back(nextState++);
+        sizeList.push_back(curCmd->memorySize());
+        _memoryUsed += sizeList.back();
         ++curIdx;
     }
     curCmd = 0;
+    trim();
+}
+
+//---------------------------------------------------------
+//   trim
+///   Drop the oldest undo macros while the memory held by
+///   the stack exceeds MScore::undoMemoryLimit.
+///   The last command can always be undone.
+//---------------------------------------------------------
+
+void UndoStack::trim()
+{
+    if (MScore::undoMemoryLimit == 0) {
+        return;
+    }
+    while (_memoryUsed > MScore::undoMemoryLimit && curIdx > 1) {
+        UndoCommand* cmd = list.takeFirst();
+        stateList.erase(stateList.begin());
+        _memoryUsed -= sizeList.front();
+        sizeList.erase(sizeList.begin());
+        cmd->cleanup(true);
+        delete cmd;
+        --curIdx;
+        ++trimmed;
+    }
 }
 
 //---------------------------------------------------------
@@ -447,6 +510,8 @@ void UndoStack::reopen()
     --curIdx;
     curCmd = list.takeAt(curIdx);
     stateList.erase(stateList.begin() + curIdx);
+    _memoryUsed -= sizeList[curIdx];
+    sizeList.erase(sizeList.begin() + curIdx);
     for (auto i : curCmd->commands()) {
         qDebug("   <%s>", i->name());
     }
@@ -471,7 +536,7 @@ void UndoStack::undo(EditData* ed)
     // Are we currently editing text?
     if (ed && ed->element && ed->element->isTextBase()) {
         TextEditData* ted = static_cast<TextEditData*>(ed->getData(ed->element));
-        if (ted && ted->startUndoIdx == curIdx) {
+        if (ted && ted->startUndoIdx == getCurIdx()) {
             // No edits to undo, so do nothing
             return;
         }
@@ -580,6 +645,52 @@ void UndoMacro::append(UndoMacro&& other)
     }
 }
 
+//---------------------------------------------------------
+//   coalesce
+///   Delete the just executed last child \p cmd if undoing
+///   the command before it restores the state before both.
+///   Returns true if \p cmd was deleted.
+//---------------------------------------------------------
+
+bool UndoMacro::coalesce(UndoCommand* cmd)
+{
+    const QList<UndoCommand*>& l = commands();
+    const int n = l.size();
+    if (n < 2 || l[n - 1] != cmd || !l[n - 2]->canCoalesce(cmd)) {
+        return false;
+    }
+    delete removeChild();
+    return true;
+}
+
+//---------------------------------------------------------
+//   collectPropertyChange
+///   Move the just executed ChangeProperty \p cmd into a
+///   ChangePropertyList at the end of this macro.
+///   Returns true if \p cmd was deleted.
+//---------------------------------------------------------
+
+bool UndoMacro::collectPropertyChange(UndoCommand* cmd)
+{
+    const QList<UndoCommand*>& l = commands();
+    const int n = l.size();
+    if (l.back() != cmd || strcmp(cmd->name(), "ChangeProperty")) {
+        return false;
+    }
+    ChangePropertyList* cl = nullptr;
+    if (n >= 2 && !strcmp(l[n - 2]->name(), "ChangePropertyList")) {
+        cl = static_cast<ChangePropertyList*>(l[n - 2]);
+    }
+    removeChild();
+    if (!cl) {
+        cl = new ChangePropertyList;
+        appendChild(cl);
+    }
+    cl->append(static_cast<ChangeProperty*>(cmd));
+    delete cmd;
+    return true;
+}
+
 //---------------------------------------------------------
 //   CloneVoice
 //---------------------------------------------------------
@@ -711,6 +822,27 @@ void AddElement::cleanup(bool undo)
     }
 }
 
+//---------------------------------------------------------
+//   setPlaylistDirtyToEnd
+//    elements changing the playback of all following notes
+//    (velocity, sound, swing, capo) invalidate the playlist
+//    up to the end of the score
+//---------------------------------------------------------
+
+static void setPlaylistDirtyToEnd(const ScoreElement* se)
+{
+    if (!se->isElement()) {
+        return;
+    }
+    const Element* e = toElement(se);
+    if (e->isSpannerSegment()) {
+        e = toSpannerSegment(e)->spanner();
+    }
+    if (e->isDynamic() || e->isHairpin() || e->isStaffTextBase()) {
+        e->score()->setPlaylistDirty(e->tick(), e->score()->endTick());
+    }
+}
+
 //---------------------------------------------------------
 //   undoRemoveTuplet
 //---------------------------------------------------------
@@ -745,6 +877,7 @@ static void undoAddTuplet(DurationElement* cr)
 
 void AddElement::endUndoRedo(bool isUndo) const
 {
+    setPlaylistDirtyToEnd(element);
     if (element->isChordRest()) {
         if (isUndo) {
             undoRemoveTuplet(toChordRest(element));
@@ -894,6 +1027,7 @@ void RemoveElement::cleanup(bool undo)
 
 void RemoveElement::undo(EditData*)
 {
+    setPlaylistDirtyToEnd(element);
     if (!element->isTuplet()) {
         element->score()->addElement(element);
     }
@@ -902,6 +1036,7 @@ void RemoveElement::undo(EditData*)
             Chord* chord = toChord(element);
             for (Note* note : chord->notes()) {
                 note->connectTiedNotes();
+                note->setPlaylistDirty();
             }
         }
         undoAddTuplet(toChordRest(element));
@@ -918,6 +1053,7 @@ void RemoveElement::undo(EditData*)
 
 void RemoveElement::redo(EditData*)
 {
+    setPlaylistDirtyToEnd(element);
     if (!element->isTuplet()) {
         element->score()->removeElement(element);
     }
@@ -954,6 +1090,35 @@ const char* RemoveElement::name() const
     return buffer;
 }
 
+//---------------------------------------------------------
+//   elementMemorySize
+//    rough estimate for an element and its tree children
+//---------------------------------------------------------
+
+static size_t elementMemorySize(const ScoreElement* e)
+{
+    size_t n = sizeof(Element);
+    for (const ScoreElement* c : *e) {
+        if (c) {
+            n += elementMemorySize(c);
+        }
+    }
+    return n;
+}
+
+//---------------------------------------------------------
+//   RemoveElement::memorySize
+//---------------------------------------------------------
+
+size_t RemoveElement::memorySize() const
+{
+    size_t n = UndoCommand::memorySize() + sizeof(RemoveElement) - sizeof(UndoCommand);
+    if (element) {
+        n += elementMemorySize(element);
+    }
+    return n;
+}
+
 //---------------------------------------------------------
 //   RemoveElement::isFiltered
 //---------------------------------------------------------
@@ -2244,6 +2409,34 @@ void MoveStaff::flip(EditData*)
 
 #endif
 
+//---------------------------------------------------------
+//   ChangeProperty::canCoalesce
+//    a later change of the same property: undo of this
+//    command restores the original value and flags
+//---------------------------------------------------------
+
+bool ChangeProperty::canCoalesce(const UndoCommand* cmd) const
+{
+    if (strcmp(name(), "ChangeProperty") || strcmp(cmd->name(), "ChangeProperty")) {
+        return false;
+    }
+    const ChangeProperty* cp = static_cast<const ChangeProperty*>(cmd);
+    return cp->element == element && cp->id == id;
+}
+
+//---------------------------------------------------------
+//   ChangeProperty::memorySize
+//---------------------------------------------------------
+
+size_t ChangeProperty::memorySize() const
+{
+    size_t n = UndoCommand::memorySize() + sizeof(ChangeProperty) - sizeof(UndoCommand);
+    if (property.userType() == QMetaType::QString) {
+        n += property.toString().size() * sizeof(QChar);
+    }
+    return n;
+}
+
 //---------------------------------------------------------
 //   ChangeProperty::flip
 //---------------------------------------------------------
@@ -2258,10 +2451,58 @@ void ChangeProperty::flip(EditData*)
 
     element->setProperty(id, property);
     element->setPropertyFlags(id, flags);
+    setPlaylistDirtyToEnd(element);
     property = v;
     flags = ps;
 }
 
+//---------------------------------------------------------
+//   ChangePropertyList
+//---------------------------------------------------------
+
+void ChangePropertyList::append(const ChangeProperty* cp)
+{
+    changes.push_back({ cp->getElement(), cp->getId(), cp->getFlags(), cp->data() });
+}
+
+void ChangePropertyList::flipChange(Change& c)
+{
+    QVariant v       = c.element->getProperty(c.id);
+    PropertyFlags ps = c.element->propertyFlags(c.id);
+
+    c.element->setProperty(c.id, c.property);
+    c.element->setPropertyFlags(c.id, c.flags);
+    setPlaylistDirtyToEnd(c.element);
+    c.property = v;
+    c.flags = ps;
+}
+
+void ChangePropertyList::undo(EditData*)
+{
+    for (auto i = changes.rbegin(); i != changes.rend(); ++i) {
+        flipChange(*i);
+    }
+}
+
+void ChangePropertyList::redo(EditData*)
+{
+    for (Change& c : changes) {
+        flipChange(c);
+    }
+}
+
+size_t ChangePropertyList::memorySize() const
+{
+    size_t n = UndoCommand::memorySize() + sizeof(ChangePropertyList) - sizeof(UndoCommand);
+    n += changes.capacity() * sizeof(Change);
+    for (const Change& c : changes) {
+        if (c.property.userType() == QMetaType::QString) {
+            n += c.property.toString().size() * sizeof(QChar);
+        }
+    }
+    return n;
+}
+
 //---------------------------------------------------------
 //   ChangeBracketProperty::flip
 //---------------------------------------------------------
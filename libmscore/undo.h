@@ -126,6 +126,8 @@ public:
 // #endif
 
     virtual bool isFiltered(Filter, const Element* /* target */) const { return false; }
+    virtual bool canCoalesce(const UndoCommand*) const { return false; }
+    virtual size_t memorySize() const;
     bool hasFilteredChildren(Filter, const Element* target) const;
     bool hasUnfilteredChildren(const std::vector<Filter>& filters, const Element* target) const;
     void filterChildren(UndoCommand::Filter f, Element* target);
@@ -165,6 +167,8 @@ public:
     virtual void redo(EditData*) override;
     bool empty() const { return childCount() == 0; }
     void append(UndoMacro&& other);
+    bool coalesce(UndoCommand*);
+    bool collectPropertyChange(UndoCommand*);
 
     UNDO_NAME("UndoMacro");
 };
@@ -178,11 +182,16 @@ class UndoStack
     UndoMacro* curCmd;
     QList<UndoMacro*> list;
     std::vector<int> stateList;
+    std::vector<size_t> sizeList;       // memorySize() of the macros in list
+    size_t _memoryUsed;
     int nextState;
     int cleanState;
     int curIdx;
+    int trimmed;                        // number of macros dropped by trim()
+    int bulkEdit;
 
     void remove(int idx);
+    void trim();
 
 public:
     UndoStack();
@@ -199,7 +208,8 @@ public:
     bool canRedo() const { return curIdx < list.size(); }
     int state() const { return stateList[curIdx]; }
     bool isClean() const { return cleanState == state(); }
-    int getCurIdx() const { return curIdx; }
+    int getCurIdx() const { return curIdx + trimmed; }
+    size_t memoryUsed() const { return _memoryUsed; }
     bool empty() const { return !canUndo() && !canRedo(); }
     UndoMacro* current() const { return curCmd; }
     UndoMacro* last() const { return curIdx > 0 ? list[curIdx - 1] : 0; }
@@ -211,6 +221,9 @@ public:
 
     void mergeCommands(int startIdx);
     void cleanRedoStack() { remove(curIdx); }
+
+    void beginBulkEdit() { ++bulkEdit; }
+    void endBulkEdit() { --bulkEdit; }
 };
 
 //---------------------------------------------------------
@@ -584,6 +597,7 @@ public:
     virtual const char* name() const override;
 
     bool isFiltered(UndoCommand::Filter f, const Element* target) const override;
+    size_t memorySize() const override;
 };
 
 //---------------------------------------------------------
@@ -1096,8 +1110,12 @@ public:
     Pid getId() const { return id; }
     ScoreElement* getElement() const { return element; }
     QVariant data() const { return property; }
+    PropertyFlags getFlags() const { return flags; }
     UNDO_NAME("ChangeProperty")
 
+    bool canCoalesce(const UndoCommand*) const override;
+    size_t memorySize() const override;
+
     bool isFiltered(UndoCommand::Filter f, const Element* target) const override
     {
         return f == UndoCommand::Filter::ChangePropertyLinked && target->linkList().contains(element);
@@ -1121,6 +1139,32 @@ public:
     UNDO_NAME("ChangeBracketProperty")
 };
 
+//---------------------------------------------------------
+//   ChangePropertyList
+//    the ChangeProperty commands of a bulk edit, stored
+//    without a command object per element
+//---------------------------------------------------------
+
+class ChangePropertyList : public UndoCommand
+{
+    struct Change {
+        ScoreElement* element;
+        Pid id;
+        PropertyFlags flags;
+        QVariant property;
+    };
+    std::vector<Change> changes;
+
+    static void flipChange(Change&);
+
+public:
+    void append(const ChangeProperty*);
+    void undo(EditData*) override;
+    void redo(EditData*) override;
+    size_t memorySize() const override;
+    UNDO_NAME("ChangePropertyList")
+};
+
 //---------------------------------------------------------
 //   ChangeMetaText
 //---------------------------------------------------------
@@ -62,11 +62,30 @@ public:
     int assignLocalIndex(const Location& mainElementInfo);
 };
 
+//---------------------------------------------------------
+//   XmlTokens
+//    pre-tokenized xml document which XmlReader can read
+//    without xml parsing, see ScoreCache
+//---------------------------------------------------------
+
+struct XmlTokens {
+    enum : char {
+        START_ELEMENT = 1,    // name, number of attributes, attribute name/value pairs
+        END_ELEMENT,
+        CHARACTERS            // text
+    };
+    QVector<QString> strings;   // all names and texts, referenced by index
+    QByteArray data;            // tokens, indices are stored as variable length integers
+};
+
 //---------------------------------------------------------
 //   XmlReader
+//    reads either xml through the privately inherited
+//    QXmlStreamReader or XmlTokens; its reading interface
+//    serves both, the stream reader is not reachable
 //---------------------------------------------------------
 
-class XmlReader : public QXmlStreamReader
+class XmlReader : private QXmlStreamReader
 {
     QString docName;    // used for error reporting
 
@@ -95,6 +114,11 @@ class XmlReader : public QXmlStreamReader
     Interval _transpose;
     QMap<int, LinkedElements*> _elinks;   // for reading old files (< 3.01)
     QMap<int, QList<QPair<LinkedElements*, Location> > > _staffLinkedElements; // one list per staff
+    struct StaffLinkIndex {
+        QHash<Location, int> first;         // first position of a location in the link list
+        int size { 0 };                     // number of list entries indexed
+    };
+    QHash<int, StaffLinkIndex> _staffLinkIndex;
     LinksIndexer _linksIndexer;
     QMultiMap<int, int> _tracks;
 
@@ -105,6 +129,26 @@ class XmlReader : public QXmlStreamReader
 
     qint64 _offsetLines { 0 };
 
+    // reading from XmlTokens:
+    XmlTokens _tokens;
+    bool _tokenMode       { false };
+    int _tokenPos         { 0 };
+    TokenType _tokenType  { NoToken };
+    int _tokenString      { -1 };             // name or text of current token
+    QVector<int> _tokenElements;              // names of open elements
+    QXmlStreamAttributes _tokenAttributes;
+    Error _tokenError     { NoError };
+    QString _tokenErrorString;
+
+    // interned property id of the current element name:
+    mutable qint64 _tagPosition { -1 };
+    mutable Pid _tagPid         { Pid::END };
+    mutable QVector<int> _tokenPids;          // per string index, -1: not yet looked up
+
+    int readTokenInt();
+    const QString& tokenText(int idx);
+    const QString& tokenText(int idx) const;
+
 public:
     XmlReader(QFile* f)
         : QXmlStreamReader(f), docName(f->fileName()) {}
@@ -114,6 +158,8 @@ public:
         : QXmlStreamReader(d), docName(st) {}
     XmlReader(const QString& d, const QString& st = QString())
         : QXmlStreamReader(d), docName(st) {}
+    XmlReader(const XmlTokens& t, const QString& st = QString())
+        : QXmlStreamReader(), docName(st), _tokens(t), _tokenMode(true) {}
     XmlReader(const XmlReader&) = delete;
     XmlReader& operator=(const XmlReader&) = delete;
     ~XmlReader();
@@ -121,6 +167,36 @@ public:
     bool hasAccidental { false };                       // used for userAccidental backward compatibility
     void unknown();
 
+    using QXmlStreamReader::TokenType;
+    using QXmlStreamReader::Error;
+    using QXmlStreamReader::ReadElementTextBehaviour;
+    using QXmlStreamReader::clear;
+    using QXmlStreamReader::addData;
+
+    // reading interface, for xml and XmlTokens input
+    TokenType readNext();
+    bool readNextStartElement();
+    QString readElementText(ReadElementTextBehaviour behaviour = ErrorOnUnexpectedElement);
+    void skipCurrentElement();
+    TokenType tokenType() const { return _tokenMode ? _tokenType : QXmlStreamReader::tokenType(); }
+    bool isStartElement() const { return tokenType() == StartElement; }
+    bool isEndElement() const { return tokenType() == EndElement; }
+    bool isCharacters() const { return tokenType() == Characters; }
+    bool isCDATA() const { return !_tokenMode && QXmlStreamReader::isCDATA(); }
+    bool isComment() const { return tokenType() == Comment; }
+    bool isWhitespace() const;
+    bool atEnd() const;
+    QStringRef name() const;
+    Pid propertyTag() const;
+    QStringRef text() const;
+    QXmlStreamAttributes attributes() const { return _tokenMode ? _tokenAttributes : QXmlStreamReader::attributes(); }
+    Error error() const { return _tokenMode ? _tokenError : QXmlStreamReader::error(); }
+    QString errorString() const { return _tokenMode ? _tokenErrorString : QXmlStreamReader::errorString(); }
+    bool hasError() const { return error() != NoError; }
+    void raiseError(const QString& message = QString());
+    qint64 lineNumber() const { return _tokenMode ? 0 : QXmlStreamReader::lineNumber(); }
+    qint64 columnNumber() const { return _tokenMode ? 0 : QXmlStreamReader::columnNumber(); }
+
     // attribute helper routines:
     QString attribute(const char* s) const { return attributes().value(s).toString(); }
     QString attribute(const char* s, const QString&) const;
@@ -201,6 +277,7 @@ public:
     void setTransposeDiatonic(int v) { _transpose.diatonic = v; }
 
     LinkedElements* getLink(bool masterScore, const Location& l, int localIndexDiff);
+    int staffLinkIndex(int staff, const Location& l);
     void addLink(Staff* staff, LinkedElements* link);
     QMap<int, LinkedElements*>& linkIds() { return _elinks; }
     QMultiMap<int, int>& tracks() { return _tracks; }
@@ -212,7 +289,11 @@ public:
     QList<std::pair<Element*, QPointF> >& fixOffsets() { return _fixOffsets; }
 
     // for reading old files (< 3.01)
-    QMap<int, QList<QPair<LinkedElements*, Location> > >& staffLinkedElements() { return _staffLinkedElements; }
+    QMap<int, QList<QPair<LinkedElements*, Location> > >& staffLinkedElements()
+    {
+        _staffLinkIndex.clear();            // may be modified by the caller
+        return _staffLinkedElements;
+    }
     void setOffsetLines(qint64 val) { _offsetLines = val; }
 };
 
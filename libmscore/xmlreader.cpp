@@ -39,6 +39,304 @@ XmlReader::~XmlReader()
     }
 }
 
+//---------------------------------------------------------
+//   readTokenInt
+//    read a variable length integer from the token stream
+//---------------------------------------------------------
+
+int XmlReader::readTokenInt()
+{
+    const char* p = _tokens.data.constData();
+    const int n   = _tokens.data.size();
+    int val       = 0;
+    int shift     = 0;
+    while (_tokenPos < n && shift < 32) {
+        uchar c = uchar(p[_tokenPos++]);
+        val |= int(c & 0x7f) << shift;
+        if (!(c & 0x80)) {
+            return val;
+        }
+        shift += 7;
+    }
+    raiseError(QString("XmlReader: corrupted token stream"));
+    return 0;
+}
+
+//---------------------------------------------------------
+//   tokenText
+//---------------------------------------------------------
+
+const QString& XmlReader::tokenText(int idx) const
+{
+    static const QString empty;
+    if (idx < 0 || idx >= _tokens.strings.size()) {
+        return empty;
+    }
+    return _tokens.strings.at(idx);
+}
+
+const QString& XmlReader::tokenText(int idx)
+{
+    if (idx < 0 || idx >= _tokens.strings.size()) {
+        raiseError(QString("XmlReader: bad string index %1").arg(idx));
+    }
+    return static_cast<const XmlReader*>(this)->tokenText(idx);
+}
+
+//---------------------------------------------------------
+//   readNext
+//---------------------------------------------------------
+
+QXmlStreamReader::TokenType XmlReader::readNext()
+{
+    if (!_tokenMode) {
+        return QXmlStreamReader::readNext();
+    }
+    if (_tokenError != NoError || _tokenType == EndDocument || _tokenType == Invalid) {
+        _tokenType = Invalid;
+        return _tokenType;
+    }
+    _tokenAttributes.clear();
+    if (_tokenType == NoToken) {
+        _tokenType = StartDocument;
+        return _tokenType;
+    }
+    if (_tokenPos >= _tokens.data.size()) {
+        if (!_tokenElements.isEmpty()) {
+            raiseError(QString("XmlReader: premature end of token stream"));
+            _tokenType = Invalid;
+        } else {
+            _tokenType = EndDocument;
+        }
+        return _tokenType;
+    }
+    switch (_tokens.data.at(_tokenPos++)) {
+    case XmlTokens::START_ELEMENT: {
+        _tokenString = readTokenInt();
+        _tokenElements.push_back(_tokenString);
+        int n = readTokenInt();
+        for (int i = 0; i < n; ++i) {
+            int attrName  = readTokenInt();
+            int attrValue = readTokenInt();
+            _tokenAttributes.append(tokenText(attrName), tokenText(attrValue));
+        }
+        _tokenType = StartElement;
+    }
+    break;
+    case XmlTokens::END_ELEMENT:
+        if (_tokenElements.isEmpty()) {
+            raiseError(QString("XmlReader: unexpected end element"));
+            break;
+        }
+        _tokenString = _tokenElements.takeLast();
+        _tokenType   = EndElement;
+        break;
+    case XmlTokens::CHARACTERS:
+        _tokenString = readTokenInt();
+        _tokenType   = Characters;
+        break;
+    default:
+        raiseError(QString("XmlReader: corrupted token stream"));
+        break;
+    }
+    if (_tokenError != NoError) {
+        _tokenType = Invalid;
+    }
+    return _tokenType;
+}
+
+//---------------------------------------------------------
+//   readNextStartElement
+//---------------------------------------------------------
+
+bool XmlReader::readNextStartElement()
+{
+    if (!_tokenMode) {
+        return QXmlStreamReader::readNextStartElement();
+    }
+    while (readNext() != Invalid) {
+        if (isEndElement()) {
+            return false;
+        } else if (isStartElement()) {
+            return true;
+        }
+    }
+    return false;
+}
+
+//---------------------------------------------------------
+//   readElementText
+//---------------------------------------------------------
+
+QString XmlReader::readElementText(ReadElementTextBehaviour behaviour)
+{
+    if (!_tokenMode) {
+        return QXmlStreamReader::readElementText(behaviour);
+    }
+    QString result;
+    if (!isStartElement()) {
+        return result;
+    }
+    for (;;) {
+        switch (readNext()) {
+        case Characters:
+            if (result.isEmpty()) {
+                result = tokenText(_tokenString);
+            } else {
+                result += tokenText(_tokenString);
+            }
+            break;
+        case EndElement:
+            return result;
+        case StartElement:
+            if (behaviour == SkipChildElements) {
+                skipCurrentElement();
+                break;
+            } else if (behaviour == IncludeChildElements) {
+                result += readElementText(behaviour);
+                break;
+            }
+            raiseError(QString("Expected character data."));
+            return result;
+        default:
+            if (_tokenError != NoError || _tokenType == Invalid) {
+                return result;
+            }
+            break;
+        }
+    }
+}
+
+//---------------------------------------------------------
+//   skipCurrentElement
+//---------------------------------------------------------
+
+void XmlReader::skipCurrentElement()
+{
+    if (!_tokenMode) {
+        QXmlStreamReader::skipCurrentElement();
+        return;
+    }
+    int depth = 1;
+    while (depth && readNext() != Invalid) {
+        if (isEndElement()) {
+            --depth;
+        } else if (isStartElement()) {
+            ++depth;
+        }
+    }
+}
+
+//---------------------------------------------------------
+//   isWhitespace
+//---------------------------------------------------------
+
+bool XmlReader::isWhitespace() const
+{
+    if (!_tokenMode) {
+        return QXmlStreamReader::isWhitespace();
+    }
+    if (_tokenType != Characters) {
+        return false;
+    }
+    for (const QChar& c : tokenText(_tokenString)) {
+        if (!c.isSpace()) {
+            return false;
+        }
+    }
+    return true;
+}
+
+//---------------------------------------------------------
+//   atEnd
+//---------------------------------------------------------
+
+bool XmlReader::atEnd() const
+{
+    if (!_tokenMode) {
+        return QXmlStreamReader::atEnd();
+    }
+    return _tokenType == EndDocument || _tokenType == Invalid || _tokenError != NoError;
+}
+
+//---------------------------------------------------------
+//   name
+//---------------------------------------------------------
+
+QStringRef XmlReader::name() const
+{
+    if (!_tokenMode) {
+        return QXmlStreamReader::name();
+    }
+    if (_tokenType == StartElement || _tokenType == EndElement) {
+        return QStringRef(&tokenText(_tokenString));
+    }
+    return QStringRef();
+}
+
+//---------------------------------------------------------
+//   propertyTag
+//    property id of the current element name or Pid::END;
+//    the name is looked up only once per element (once per
+//    distinct name when reading tokens), so readers can
+//    dispatch on the id instead of comparing strings
+//---------------------------------------------------------
+
+Pid XmlReader::propertyTag() const
+{
+    if (tokenType() != StartElement) {
+        return Pid::END;
+    }
+    if (_tokenMode) {
+        if (_tokenPids.size() != _tokens.strings.size()) {
+            _tokenPids.fill(-1, _tokens.strings.size());
+        }
+        if (_tokenString < 0 || _tokenString >= _tokenPids.size()) {
+            return Pid::END;
+        }
+        int& pid = _tokenPids[_tokenString];
+        if (pid == -1) {
+            pid = int(propertyId(name()));
+        }
+        return Pid(pid);
+    }
+    const qint64 position = characterOffset();
+    if (position != _tagPosition) {
+        _tagPosition = position;
+        _tagPid = propertyId(name());
+    }
+    return _tagPid;
+}
+
+//---------------------------------------------------------
+//   text
+//---------------------------------------------------------
+
+QStringRef XmlReader::text() const
+{
+    if (!_tokenMode) {
+        return QXmlStreamReader::text();
+    }
+    if (_tokenType == Characters) {
+        return QStringRef(&tokenText(_tokenString));
+    }
+    return QStringRef();
+}
+
+//---------------------------------------------------------
+//   raiseError
+//---------------------------------------------------------
+
+void XmlReader::raiseError(const QString& message)
+{
+    if (!_tokenMode) {
+        QXmlStreamReader::raiseError(message);
+        return;
+    }
+    _tokenError       = CustomError;
+    _tokenErrorString = message;
+}
+
 //---------------------------------------------------------
 //   intAttribute
 //---------------------------------------------------------
@@ -206,7 +504,7 @@ Fraction XmlReader::readFraction()
 
 void XmlReader::unknown()
 {
-    if (QXmlStreamReader::error()) {
+    if (error()) {
         qDebug("%s ", qPrintable(errorString()));
     }
     if (!docName.isEmpty()) {
@@ -697,6 +995,7 @@ void XmlReader::addLink(Staff* s, LinkedElements* link)
             && (link->mainElement()->score() != staffLinks.front().first->mainElement()->score())
             ) {
             staffLinks.clear();
+            _staffLinkIndex.remove(staff);
         }
     }
 
@@ -725,24 +1024,43 @@ LinkedElements* XmlReader::getLink(bool masterScore, const Location& l, int loca
         staffLinks.push_back(staffLinks.constLast());     // nothing should reference exactly this local index, so it shouldn't matter what to append
     }
 
-    for (int i = 0; i < staffLinks.size(); ++i) {
-        if (staffLinks[i].second == l) {
-            if (localIndex == 0) {
-                return staffLinks[i].first;
-            }
-            i += localIndex;
-            if ((i < 0) || (i >= staffLinks.size())) {
-                return nullptr;
-            }
-            if (staffLinks[i].second == l) {
-                return staffLinks[i].first;
-            }
-            return nullptr;
-        }
+    int i = staffLinkIndex(staff, l);
+    if (i == -1) {
+        return nullptr;
+    }
+    if (localIndex == 0) {
+        return staffLinks[i].first;
+    }
+    i += localIndex;
+    if ((i < 0) || (i >= staffLinks.size())) {
+        return nullptr;
+    }
+    if (staffLinks[i].second == l) {
+        return staffLinks[i].first;
     }
     return nullptr;
 }
 
+//---------------------------------------------------------
+//   staffLinkIndex
+//    position of the first link at location l in the
+//    link list of staff, -1 if there is none; the hash is
+//    extended lazily as links are appended to the list
+//---------------------------------------------------------
+
+int XmlReader::staffLinkIndex(int staff, const Location& l)
+{
+    const QList<QPair<LinkedElements*, Location> >& staffLinks = _staffLinkedElements[staff];
+    StaffLinkIndex& index = _staffLinkIndex[staff];
+    for (; index.size < staffLinks.size(); ++index.size) {
+        const Location& loc = staffLinks[index.size].second;
+        if (!index.first.contains(loc)) {
+            index.first.insert(loc, index.size);
+        }
+    }
+    return index.first.value(l, -1);
+}
+
 //---------------------------------------------------------
 //   assignLocalIndex
 //---------------------------------------------------------
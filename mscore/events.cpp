@@ -1261,6 +1261,7 @@ void ScoreView::changeState(ViewState s)
     }
 
     state = s;
+    invalidatePageTiles();
     mscore->changeState(mscoreState());
     if (mscoreState() & STATE_ALLTEXTUAL_EDIT) {
         setMouseTracking(true);
@@ -33,6 +33,7 @@
 #include "instrdialog.h"
 #include "libmscore/score.h"
 #include "libmscore/page.h"
+#include "libmscore/pagerender.h"
 #include "libmscore/dynamic.h"
 #include "file.h"
 #include "libmscore/style.h"
@@ -98,7 +99,7 @@ extern void importSoundfont(QString name);
 extern MasterSynthesizer* synti;
 
 //---------------------------------------------------------
-//   paintElement(s)
+//   paintElement
 //---------------------------------------------------------
 
 static void paintElement(QPainter& p, const Element* e)
@@ -109,16 +110,6 @@ static void paintElement(QPainter& p, const Element* e)
     p.translate(-pos);
 }
 
-static void paintElements(QPainter& p, const QList<Element*>& el)
-{
-    for (Element* e : el) {
-        if (!e->visible()) {
-            continue;
-        }
-        paintElement(p, e);
-    }
-}
-
 //---------------------------------------------------------
 //   createDefaultFileName
 //---------------------------------------------------------
@@ -894,7 +885,6 @@ MasterScore* MuseScore::getNewFile()
     if (synti) {
         score->setSynthesizerState(synti->state());
     }
-
     // Call this even if synti doesn't exist - we need to rebuild either way
     score->rebuildAndUpdateExpressive(MuseScore::synthesizer("Fluid"));
 
@@ -1996,6 +1986,10 @@ bool MuseScore::exportParts()
     QString confirmReplaceMessage = tr("\"%1\" already exists.\nDo you want to replace it?\n");
     QString replaceMessage = tr("Replace");
     QString skipMessage = tr("Skip");
+    // MusicXML parts are collected and exported together, see below
+    const bool musicXml = ext == "mxl" || ext == "musicxml" || ext == "xml";
+    QList<Score*> xmlScores;
+    QStringList xmlNames;
     foreach (Excerpt* e, thisScore->excerpts()) {
         Score* pScore = e->partScore();
         QString partfn = fi.absolutePath() + "/" + fi.completeBaseName() + "-"
@@ -2023,10 +2017,16 @@ bool MuseScore::exportParts()
             }
         }
 
-        if (!saveAs(pScore, true, partfn, ext)) {
+        if (musicXml) {
+            xmlScores.append(pScore);
+            xmlNames.append(partfn);
+        } else if (!saveAs(pScore, true, partfn, ext)) {
             return false;
         }
     }
+    if (!xmlScores.isEmpty() && !saveXmlParts(xmlScores, xmlNames, ext == "mxl")) {
+        return false;
+    }
     // For PDF, also export score and parts together
     if (ext.toLower() == "pdf") {
         QList<Score*> scores;
@@ -2074,6 +2074,7 @@ bool MuseScore::saveAs(Score* cs_, bool saveCopy, const QString& path, const QSt
         fn += suffix;
     }
 
+    cs_->masterScore()->doPendingPartsLayout();
     LayoutMode layoutMode = cs_->layoutMode();
     if (ext == "mscx" || ext == "mscz") {
         // save as mscore *.msc[xz] file
@@ -2214,6 +2215,27 @@ bool MuseScore::saveMidi(Score* score, QIODevice* device)
                         PREF_IO_MIDI_EXPORTRPNS), synthesizerState());
 }
 
+//---------------------------------------------------------
+//   pdfTitle
+//    PDF meta data title of a score or part
+//---------------------------------------------------------
+
+static QString pdfTitle(Score* cs_)
+{
+    QString title = cs_->metaTag("workTitle");
+    if (title.isEmpty()) { // workTitle unset?
+        title = cs_->masterScore()->title();     // fall back to (master)score's tab title
+    }
+    if (!cs_->isMaster()) {   // excerpt?
+        QString partname = cs_->metaTag("partName");
+        if (partname.isEmpty()) {   // partName unset?
+            partname = cs_->title();       // fall back to excerpt's tab title
+        }
+        title += " - " + partname;
+    }
+    return title;
+}
+
 //---------------------------------------------------------
 //   savePdf
 //---------------------------------------------------------
@@ -2225,9 +2247,12 @@ bool MuseScore::savePdf(const QString& saveName)
 
 bool MuseScore::savePdf(Score* cs_, const QString& saveName)
 {
-    QPrinter printer;
-    printer.setOutputFileName(saveName);
-    return savePdf(cs_, printer);
+    cs_->doPendingLayout();
+    QFile f(saveName);
+    if (!f.open(QIODevice::WriteOnly)) {
+        return false;
+    }
+    return PageRender::pdf({ cs_ }, &f, preferences.getInt(PREF_EXPORT_PDF_DPI), pdfTitle(cs_));
 }
 
 bool MuseScore::savePdf(Score* cs_, QPrinter& printer)
@@ -2251,18 +2276,7 @@ bool MuseScore::savePdf(Score* cs_, QPrinter& printer)
         qDebug("unable to clear printer margins");
     }
 
-    QString title = cs_->metaTag("workTitle");
-    if (title.isEmpty()) { // workTitle unset?
-        title = cs_->masterScore()->title();     // fall back to (master)score's tab title
-    }
-    if (!cs_->isMaster()) {   // excerpt?
-        QString partname = cs_->metaTag("partName");
-        if (partname.isEmpty()) {   // partName unset?
-            partname = cs_->title();       // fall back to excerpt's tab title
-        }
-        title += " - " + partname;
-    }
-    printer.setDocName(title);   // set PDF's meta data for Title
+    printer.setDocName(pdfTitle(cs_));   // set PDF's meta data for Title
 
     QPainter p;
     if (!p.begin(&printer)) {
@@ -2301,89 +2315,36 @@ bool MuseScore::savePdf(QList<Score*> cs_, const QString& saveName)
     if (cs_.empty()) {
         return false;
     }
-    Score* firstScore = cs_[0];
-
-    QPrinter printer;
-    printer.setOutputFileName(saveName);
-    printer.setResolution(preferences.getInt(PREF_EXPORT_PDF_DPI));
-    QSizeF size(firstScore->styleD(Sid::pageWidth), firstScore->styleD(Sid::pageHeight));
-    QPageSize ps(QPageSize::id(size, QPageSize::Inch, QPageSize::FuzzyOrientationMatch));
-    printer.setPageSize(ps);
-    printer.setPageOrientation(size.width() > size.height() ? QPageLayout::Landscape : QPageLayout::Portrait);
-    printer.setFullPage(true);
-    printer.setColorMode(QPrinter::Color);
-#if defined(Q_OS_MAC)
-    printer.setOutputFormat(QPrinter::NativeFormat);
-#else
-    printer.setOutputFormat(QPrinter::PdfFormat);
-#endif
-
-    printer.setCreator("MuseScore Version: " VERSION);
-    if (!printer.setPageMargins(QMarginsF())) {
-        qDebug("unable to clear printer margins");
+    QList<LayoutMode> layoutModes;
+    for (Score* s : cs_) {
+        s->doPendingLayout();
+        layoutModes.append(s->layoutMode());
+        if (s->layoutMode() != LayoutMode::PAGE) {
+            s->setLayoutMode(LayoutMode::PAGE);
+        }
+        s->doLayout();
     }
+    Score* firstScore = cs_[0];
 
     QString title = firstScore->metaTag("workTitle");
     if (title.isEmpty()) { // workTitle unset?
         title = firstScore->title();     // fall back to (master)score's tab title
     }
     title += " - " + tr("Score and Parts");
-    printer.setDocName(title);   // set PDF's meta data for Title
-
-    QPainter p;
-    if (!p.begin(&printer)) {
-        return false;
-    }
-
-    p.setRenderHint(QPainter::Antialiasing, true);
-    p.setRenderHint(QPainter::TextAntialiasing, true);
-
-    double pr = MScore::pixelRatio;
-
-    bool firstPage = true;
-    for (Score* s : cs_) {
-        LayoutMode layoutMode = s->layoutMode();
-        if (layoutMode != LayoutMode::PAGE) {
-            s->setLayoutMode(LayoutMode::PAGE);
-            //      s->doLayout();
-        }
-        s->doLayout();
-
-        // done in Score::print() also, but do it here as well to be safe
-        s->setPrinting(true);
-        MScore::pdfPrinting = true;
-
-        QSizeF size1(s->styleD(Sid::pageWidth), s->styleD(Sid::pageHeight));
-        QPageSize ps1(QPageSize::id(size1, QPageSize::Inch, QPageSize::FuzzyOrientationMatch));
-        printer.setPageSize(ps1);
-        printer.setPageOrientation(size1.width() > size1.height() ? QPageLayout::Landscape : QPageLayout::Portrait);
-        p.setViewport(QRect(0.0, 0.0, size1.width() * printer.logicalDpiX(),
-                            size1.height() * printer.logicalDpiY()));
-        p.setWindow(QRect(0.0, 0.0, size1.width() * DPI, size1.height() * DPI));
-
-        MScore::pixelRatio = DPI / printer.logicalDpiX();
-        const QList<Page*> pl = s->pages();
-        int pages    = pl.size();
-        for (int n = 0; n < pages; ++n) {
-            if (!firstPage) {
-                printer.newPage();
-            }
-            firstPage = false;
-            s->print(&p, n);
-        }
-        MScore::pixelRatio = pr;
 
-        //reset score
-        s->setPrinting(false);
-        MScore::pdfPrinting = false;
+    QFile f(saveName);
+    bool rv = f.open(QIODevice::WriteOnly)
+              && PageRender::pdf(cs_, &f, preferences.getInt(PREF_EXPORT_PDF_DPI), title);
 
-        if (layoutMode != s->layoutMode()) {
-            s->setLayoutMode(layoutMode);
+    //reset scores
+    for (int i = 0; i < cs_.size(); ++i) {
+        Score* s = cs_[i];
+        if (layoutModes[i] != s->layoutMode()) {
+            s->setLayoutMode(layoutModes[i]);
             s->doLayout();
         }
     }
-    p.end();
-    return true;
+    return rv;
 }
 
 //---------------------------------------------------------
@@ -2877,74 +2838,12 @@ bool MuseScore::savePng(Score* score, const QString& name)
 
 bool MuseScore::savePng(Score* score, QIODevice* device, int pageNumber, bool drawPageBackground)
 {
-    const bool screenshot = false;
     const bool transparent = preferences.getBool(PREF_EXPORT_PNG_USETRANSPARENCY) && !drawPageBackground;
     const double convDpi = preferences.getDouble(PREF_EXPORT_PNG_RESOLUTION);
-    const int localTrimMargin = trimMargin;
-    const QImage::Format format = QImage::Format_ARGB32_Premultiplied;
 
-    bool rv = true;
-    score->setPrinting(!screenshot);      // don’t print page break symbols etc.
-    double pr = MScore::pixelRatio;
-
-    QImage::Format f;
-    if (format != QImage::Format_Indexed8) {
-        f = format;
-    } else {
-        f = QImage::Format_ARGB32_Premultiplied;
-    }
-
-    const QList<Page*>& pl = score->pages();
-
-    Page* page = pl.at(pageNumber);
-    QRectF r;
-    if (localTrimMargin >= 0) {
-        QMarginsF margins(localTrimMargin, localTrimMargin, localTrimMargin, localTrimMargin);
-        r = page->tbbox() + margins;
-    } else {
-        r = page->abbox();
-    }
-    int w = lrint(r.width() * convDpi / DPI);
-    int h = lrint(r.height() * convDpi / DPI);
-
-    QImage printer(w, h, f);
-    printer.setDotsPerMeterX(lrint((convDpi * 1000) / INCH));
-    printer.setDotsPerMeterY(lrint((convDpi * 1000) / INCH));
-
-    printer.fill(transparent ? 0 : 0xffffffff);
-    double mag_ = convDpi / DPI;
-    MScore::pixelRatio = 1.0 / mag_;
-
-    QPainter p(&printer);
-    p.setRenderHint(QPainter::Antialiasing, true);
-    p.setRenderHint(QPainter::TextAntialiasing, true);
-    p.scale(mag_, mag_);
-    if (localTrimMargin >= 0) {
-        p.translate(-r.topLeft());
-    }
-
-    QList< Element*> pel = page->elements();
-    std::stable_sort(pel.begin(), pel.end(), elementLessThan);
-    paintElements(p, pel);
-    if (format == QImage::Format_Indexed8) {
-        //convert to grayscale & respect alpha
-        QVector<QRgb> colorTable;
-        colorTable.push_back(QColor(0, 0, 0, 0).rgba());
-        if (!transparent) {
-            for (int i = 1; i < 256; i++) {
-                colorTable.push_back(QColor(i, i, i).rgb());
-            }
-        } else {
-            for (int i = 1; i < 256; i++) {
-                colorTable.push_back(QColor(0, 0, 0, i).rgba());
-            }
-        }
-        printer = printer.convertToFormat(QImage::Format_Indexed8, colorTable);
-    }
-    printer.save(device, "png");
-    score->setPrinting(false);
-    MScore::pixelRatio = pr;
-    return rv;
+    Page* page = score->pages().at(pageNumber);
+    QImage image = PageRender::image(page, convDpi, transparent, trimMargin);
+    return image.save(device, "png");
 }
 
 //---------------------------------------------------------
@@ -3125,6 +3024,7 @@ bool MuseScore::saveSvg(Score* score, QIODevice* device, int pageNumber, bool dr
     SvgGenerator printer;
     printer.setTitle(pages > 1 ? QString("%1 (%2)").arg(title).arg(pageNumber + 1) : title);
     printer.setOutputDevice(device);
+    printer.setReusePaths(preferences.getBool(PREF_EXPORT_SVG_REUSEPATHS));
 
     QRectF r;
     if (trimMargin >= 0) {
@@ -3242,6 +3142,40 @@ bool MuseScore::saveSvg(Score* score, QIODevice* device, int pageNumber, bool dr
     return true;
 }
 
+//---------------------------------------------------------
+//   thumbnailCachePath
+//    generated thumbnails are kept on disk, named by a hash
+//    of the score file contents
+//---------------------------------------------------------
+
+static QString thumbnailCachePath(const QString& name)
+{
+    QFile f(name);
+    if (!f.open(QIODevice::ReadOnly)) {
+        return QString();
+    }
+    QCryptographicHash h(QCryptographicHash::Sha1);
+    if (!h.addData(&f)) {
+        return QString();
+    }
+    return QStandardPaths::writableLocation(QStandardPaths::CacheLocation)
+           + "/thumbnails/" + QString::fromLatin1(h.result().toHex()) + ".png";
+}
+
+//---------------------------------------------------------
+//   pruneThumbnailCache
+//    keep the most recently written thumbnails
+//---------------------------------------------------------
+
+static void pruneThumbnailCache(const QDir& dir)
+{
+    static const int MAX_THUMBNAILS = 500;
+    const QFileInfoList files = dir.entryInfoList({ "*.png" }, QDir::Files, QDir::Time);
+    for (int i = MAX_THUMBNAILS; i < files.size(); ++i) {
+        QFile::remove(files[i].filePath());
+    }
+}
+
 //---------------------------------------------------------
 //   createThumbnail
 //---------------------------------------------------------
@@ -3251,6 +3185,11 @@ static QPixmap createThumbnail(const QString& name)
     if (!(name.endsWith(".mscx") || name.endsWith(".mscz"))) {
         return QPixmap();
     }
+    const QString cachePath = thumbnailCachePath(name);
+    QImage pm;
+    if (!cachePath.isEmpty() && pm.load(cachePath, "PNG")) {
+        return QPixmap::fromImage(pm);
+    }
     MasterScore* score = new MasterScore(MScore::defaultStyle());
     Score::FileError error = readScore(score, name, true);
     if (error != Score::FileError::FILE_NO_ERROR || !score->firstMeasure()) {
@@ -3258,8 +3197,15 @@ static QPixmap createThumbnail(const QString& name)
         return QPixmap();
     }
     score->doLayout();
-    QImage pm = score->createThumbnail();
+    pm = score->createThumbnail();
     delete score;
+
+    if (!cachePath.isEmpty()) {
+        const QDir dir = QFileInfo(cachePath).dir();
+        if (dir.mkpath(".") && pm.save(cachePath, "PNG")) {
+            pruneThumbnailCache(dir);
+        }
+    }
     return QPixmap::fromImage(pm);
 }
 
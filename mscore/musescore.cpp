@@ -430,6 +430,9 @@ void updateExternalValuesFromPreferences()
     MScore::layoutBreakColor = preferences.getColor(PREF_UI_SCORE_LAYOUTBREAKCOLOR);
     MScore::frameMarginColor = preferences.getColor(PREF_UI_SCORE_FRAMEMARGINCOLOR);
     MScore::setVerticalOrientation(preferences.getBool(PREF_UI_CANVAS_SCROLL_VERTICALORIENTATION));
+    MScore::deferPartLayout = !MScore::noGui && preferences.getBool(PREF_APP_DEFERPARTLAYOUT);
+    MScore::deferExcerpts = preferences.getBool(PREF_APP_DEFERPARTSLOADING);
+    MScore::undoMemoryLimit = size_t(qMax(preferences.getInt(PREF_APP_UNDOMEMORYLIMIT), 0)) * 1024 * 1024;   // MB
 
     MScore::selectColor[0] = preferences.getColor(PREF_UI_SCORE_VOICE1_COLOR);
     MScore::selectColor[1] = preferences.getColor(PREF_UI_SCORE_VOICE2_COLOR);
@@ -2019,6 +2022,10 @@ MuseScore::MuseScore()
     autoSaveTimer = new QTimer(this);
     autoSaveTimer->setSingleShot(true);
     connect(autoSaveTimer, SIGNAL(timeout()), this, SLOT(autoSaveTimerTimeout()));
+    partLayoutTimer = new QTimer(this);
+    partLayoutTimer->setSingleShot(true);
+    partLayoutTimer->setInterval(500);
+    connect(partLayoutTimer, SIGNAL(timeout()), this, SLOT(partLayoutTimerTimeout()));
     initOsc();
     startAutoSave();
 
@@ -5452,6 +5459,26 @@ void MuseScore::removeSessionFile()
     }
 }
 
+//---------------------------------------------------------
+//   partLayoutTimerTimeout
+//    lay out the part scores not on display while idle,
+//    one at a time to stay responsive
+//---------------------------------------------------------
+
+void MuseScore::partLayoutTimerTimeout()
+{
+    if (!cs) {
+        return;
+    }
+    for (Score* s : cs->masterScore()->scoreList()) {
+        if (s->layoutPending()) {
+            s->doPendingLayout();
+            partLayoutTimer->start();
+            return;
+        }
+    }
+}
+
 //---------------------------------------------------------
 //   autoSaveTimerTimeout
 //---------------------------------------------------------
@@ -6410,6 +6437,10 @@ void MuseScore::endCmd(const bool isCmdFromInspector, const bool undoRedo)
 
         getAction("concert-pitch")->setChecked(cs->styleB(Sid::concertPitch));
 
+        if (MScore::deferPartLayout) {
+            partLayoutTimer->start();         // restarted by every command
+        }
+
         if (e == 0 && cs->noteEntryMode()) {
             e = cs->inputState().cr();
         }
@@ -7923,6 +7954,7 @@ MuseScoreApplication::CommandLineParseResult MuseScoreApplication::parseCommandL
     parser.addOption(QCommandLineOption({ "P", "export-score-parts" },
                                         "Use with '-o <file>.pdf', export score and parts"));
     parser.addOption(QCommandLineOption("no-fallback-font", "Don't use Bravura as fallback musical font"));
+    parser.addOption(QCommandLineOption("score-cache", "Keep binary cache files next to scores to speed up reopening them"));
     parser.addOption(QCommandLineOption({ "f", "force" },
                                         "Use with '-o <file>', ignore warnings reg. score being corrupted or from wrong version"));
     parser.addOption(QCommandLineOption({ "b", "bitrate" }, "Use with '-o <file>.mp3', sets bitrate, in kbps",
@@ -7968,6 +8000,7 @@ MuseScoreApplication::CommandLineParseResult MuseScoreApplication::parseCommandL
     midiInputTrace = parser.isSet("I");
     midiOutputTrace = parser.isSet("O");
     MScore::useFallbackFont = !parser.isSet("no-fallback-font");
+    MScore::useScoreCache = parser.isSet("score-cache");
 
     if ((converterMode = parser.isSet("o"))) {
         MScore::noGui = true;
@@ -336,6 +336,7 @@ class MuseScore : public QMainWindow, public MuseScoreCore
 #endif
 
     QTimer* autoSaveTimer;
+    QTimer* partLayoutTimer;
     QList<QAction*> pluginActions;
 
     PianorollEditor* pianorollEditor   { 0 };
@@ -493,6 +494,7 @@ signals:
 private slots:
     void cmd(QAction* a, const QString& cmd);
     void autoSaveTimerTimeout();
+    void partLayoutTimerTimeout();
     void helpBrowser1() const;
     void resetAndRestart();
     void about();
@@ -941,6 +943,7 @@ extern bool saveMxl(Score*, const QString& name);
 extern bool saveMxl(Score*, QIODevice*);
 extern bool saveXml(Score*, QIODevice*);
 extern bool saveXml(Score*, const QString& name);
+extern bool saveXmlParts(const QList<Score*>&, const QStringList& names, bool compressed);
 
 extern QString getSharePath();
 
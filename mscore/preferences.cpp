@@ -152,6 +152,9 @@ void Preferences::init(bool storeInMemoryOnly)
             { PREF_APP_STARTUP_TELEMETRY_ACCESS_REQUESTED,          new StringPreference("", false) },
             { PREF_APP_BACKUP_GENERATE_BACKUP,                      new BoolPreference(true) },
             { PREF_APP_BACKUP_SUBFOLDER,                            new StringPreference(".mscbackup") },
+            { PREF_APP_DEFERPARTSLOADING,                           new BoolPreference(false, false) },
+            { PREF_APP_DEFERPARTLAYOUT,                             new BoolPreference(true, false) },
+            { PREF_APP_UNDOMEMORYLIMIT,                             new IntPreference(512, false) },
             { PREF_EXPORT_AUDIO_NORMALIZE,                          new BoolPreference(true) },
             { PREF_EXPORT_AUDIO_SAMPLERATE,                         new IntPreference(44100, false) },
             { PREF_EXPORT_AUDIO_PCMRATE,                            new IntPreference(16) },
@@ -162,6 +165,7 @@ void Preferences::init(bool storeInMemoryOnly)
             { PREF_EXPORT_PDF_DPI,                                  new IntPreference(300, false) },
             { PREF_EXPORT_PNG_RESOLUTION,                           new DoublePreference(DPI, false) },
             { PREF_EXPORT_PNG_USETRANSPARENCY,                      new BoolPreference(true, false) },
+            { PREF_EXPORT_SVG_REUSEPATHS,                           new BoolPreference(false, false) },
             { PREF_IMPORT_GUITARPRO_CHARSET,                        new StringPreference("UTF-8", false) },
             { PREF_IMPORT_MUSICXML_IMPORTBREAKS,                    new BoolPreference(true, false) },
             { PREF_IMPORT_MUSICXML_IMPORTLAYOUT,                    new BoolPreference(true, false) },
@@ -219,6 +223,7 @@ void Preferences::init(bool storeInMemoryOnly)
                                    absoluteFilePath(), false) },
             { PREF_UI_CANVAS_MISC_ANTIALIASEDDRAWING,               new BoolPreference(true, false) },
             { PREF_UI_CANVAS_MISC_SELECTIONPROXIMITY,               new IntPreference(6, false) },
+            { PREF_UI_CANVAS_MISC_LEVELOFDETAILSPATIUM,             new DoublePreference(2.0, false) },
             { PREF_UI_CANVAS_SCROLL_LIMITSCROLLAREA,                new BoolPreference(false, false) },
             { PREF_UI_CANVAS_SCROLL_VERTICALORIENTATION,            new BoolPreference(false, false) },
             { PREF_UI_APP_STARTUP_CHECKUPDATE,                      new BoolPreference(checkUpdateStartup, false) },
@@ -583,6 +588,7 @@ QMap<QString, QVariant> Preferences::getDefaultLocalPreferences()
                        PREF_UI_CANVAS_FG_WALLPAPER,
                        PREF_UI_CANVAS_MISC_ANTIALIASEDDRAWING,
                        PREF_UI_CANVAS_MISC_SELECTIONPROXIMITY,
+                       PREF_UI_CANVAS_MISC_LEVELOFDETAILSPATIUM,
                        PREF_UI_CANVAS_SCROLL_LIMITSCROLLAREA,
                        PREF_UI_CANVAS_SCROLL_VERTICALORIENTATION,
                        PREF_UI_APP_SHOWSTATUSBAR,
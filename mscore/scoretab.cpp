@@ -509,7 +509,19 @@ bool ScoreTab::setCurrentScore(Score* s)
     if (idx == -1) {
         return false;
     }
-    const int exIdx = (ms == s) ? 0 : ms->scoreList().indexOf(s);
+    // scoreList() skips deferred parts, excerpt tabs follow excerpts()
+    int exIdx = -1;
+    if (ms == s) {
+        exIdx = 0;
+    } else {
+        const QList<Excerpt*>& excerpts = ms->excerpts();
+        for (int i = 0; i < excerpts.size(); ++i) {
+            if (!excerpts[i]->isDeferred() && excerpts[i]->partScore() == s) {
+                exIdx = i + 1;
+                break;
+            }
+        }
+    }
     if (exIdx == -1) {
         return false;
     }
@@ -541,6 +553,9 @@ void ScoreTab::removeTab(int idx, bool noCurrentChangedSignal)
         }
     }
     foreach (Excerpt* excerpt, score->excerpts()) {
+        if (excerpt->isDeferred()) {        // not loaded, has no view
+            continue;
+        }
         Score* sc = excerpt->partScore();
         for (int i = 0; i < stack->count(); ++i) {
             QSplitter* vs = static_cast<QSplitter*>(stack->widget(i));
@@ -121,6 +121,7 @@ ScoreView::ScoreView(QWidget* parent)
     setAttribute(Qt::WA_KeyCompression);
     setAttribute(Qt::WA_StaticContents);
     setAutoFillBackground(false);
+    _pageTiles.setMaxCost(64 * 1024 * 1024);      // bytes
 
     state       = ViewState::NORMAL;
     _score      = 0;
@@ -227,6 +228,7 @@ void ScoreView::setScore(Score* s)
     }
 
     _score = s;
+    invalidatePageTiles();
     if (_score) {
         if (_score->isMaster()) {
             MasterScore* ms = static_cast<MasterScore*>(s);
@@ -533,6 +535,7 @@ void ScoreView::setForeground(QPixmap* pm)
 {
     delete _fgPixmap;
     _fgPixmap = pm;
+    invalidatePageTiles();
     update();
 }
 
@@ -541,6 +544,7 @@ void ScoreView::setForeground(const QColor& color)
     delete _fgPixmap;
     _fgPixmap = 0;
     _fgColor = color;
+    invalidatePageTiles();
     update();
 }
 
@@ -550,6 +554,7 @@ void ScoreView::setForeground(const QColor& color)
 
 void ScoreView::dataChanged(const QRectF& r)
 {
+    invalidatePageTiles(r);
     update(_matrix.mapRect(r).toRect());    // generate paint event
 }
 
@@ -1058,6 +1063,21 @@ void ScoreView::drawAnchorLines(QPainter& painter)
     }
 }
 
+//---------------------------------------------------------
+//   showEvent
+//    catch up with the layout deferred while the score
+//    was not displayed
+//---------------------------------------------------------
+
+void ScoreView::showEvent(QShowEvent* ev)
+{
+    if (_score && _score->layoutPending()) {
+        _score->doPendingLayout();
+        updateAll();
+    }
+    QWidget::showEvent(ev);
+}
+
 //---------------------------------------------------------
 //   paintEvent
 //    Note: desktop background and paper background are not
@@ -1228,6 +1248,226 @@ void ScoreView::drawElements(QPainter& painter, QList<Element*>& el, Element* ed
     }
 }
 
+//---------------------------------------------------------
+//   pageTilesUsable
+//    page tiles are only used while the elements are drawn
+//    the same way as in the last paint event; not during
+//    playback, Seq marks played notes and repaints them
+//    without invalidating the tiles
+//---------------------------------------------------------
+
+bool ScoreView::pageTilesUsable() const
+{
+    if (state != ViewState::NORMAL && state != ViewState::NOTE_ENTRY) {
+        return false;
+    }
+#ifndef NDEBUG
+    if (MScore::showBoundingRect || MScore::showSystemBoundingRect || MScore::showSegmentShapes
+        || MScore::showSkylines || MScore::showCorruptedMeasures) {
+        return false;
+    }
+#endif
+    return !editData.element && !dropTarget && !dropRectangle.isValid()
+           && !_score->printing() && _score->layoutMode() == LayoutMode::PAGE;
+}
+
+//---------------------------------------------------------
+//   invalidatePageTiles
+//    r is in canvas coordinates
+//---------------------------------------------------------
+
+void ScoreView::invalidatePageTiles(const QRectF& r)
+{
+    for (const PageTileKey& key : _pageTiles.keys()) {
+        if (_pageTiles.object(key)->canvasRect.intersects(r)) {
+            _pageTiles.remove(key);
+        }
+    }
+    for (auto i = _systemSummaries.begin(); i != _systemSummaries.end();) {
+        if (i->canvasRect.intersects(r)) {
+            i = _systemSummaries.erase(i);
+        } else {
+            ++i;
+        }
+    }
+    _pageElementBounds.clear();         // r may have moved an element across them
+}
+
+//---------------------------------------------------------
+//   pageElementBounds
+//    the page rectangle extended by the elements of the
+//    page which reach past it, in canvas coordinates
+//---------------------------------------------------------
+
+QRectF ScoreView::pageElementBounds(Page* page)
+{
+    auto i = _pageElementBounds.constFind(page);
+    if (i != _pageElementBounds.cend()) {
+        return *i;
+    }
+    QRectF r = page->abbox();
+    for (const Element* e : page->elements()) {
+        r |= e->pageBoundingRect();
+    }
+    r.translate(page->pos());
+    _pageElementBounds.insert(page, r);
+    return r;
+}
+
+//---------------------------------------------------------
+//   systemSummary
+//    built on first use, dropped with the page tiles
+//---------------------------------------------------------
+
+const SystemSummary& ScoreView::systemSummary(const System* system)
+{
+    auto i = _systemSummaries.find(system);
+    if (i != _systemSummaries.end()) {
+        return *i;
+    }
+    SystemSummary& s = _systemSummaries[system];
+    s.canvasRect = system->canvasBoundingRect();
+    const int nstaves = _score->nstaves();
+    for (MeasureBase* mb : system->measures()) {
+        if (!mb->isMeasure()) {
+            s.frames.append(mb->pageBoundingRect());
+            continue;
+        }
+        Measure* m = toMeasure(mb);
+        qreal top    = 0.0;
+        qreal bottom = 0.0;
+        bool empty   = true;
+        for (int staffIdx = 0; staffIdx < nstaves; ++staffIdx) {
+            StaffLines* sl = m->staffLines(staffIdx);
+            if (!system->staff(staffIdx)->show() || !sl->visible() || sl->getLines().isEmpty()) {
+                continue;
+            }
+            const QPointF pos(sl->pagePos());
+            for (const QLineF& l : sl->getLines()) {
+                s.lines.append(l.translated(pos));
+            }
+            if (empty) {
+                top   = sl->getLines().front().y1() + pos.y();
+                empty = false;
+            }
+            bottom = sl->getLines().back().y1() + pos.y();
+        }
+        if (empty) {
+            continue;
+        }
+        const qreal x = m->pagePos().x() + m->width();
+        s.lines.append(QLineF(x, top, x, bottom));
+
+        for (Segment* seg = m->first(SegmentType::ChordRest); seg; seg = seg->next(SegmentType::ChordRest)) {
+            for (int track = 0; track < nstaves * VOICES; ++track) {
+                Element* e = seg->element(track);
+                if (!e || !e->isChord() || !e->visible() || !system->staff(track / VOICES)->show()) {
+                    continue;
+                }
+                for (const Note* note : toChord(e)->notes()) {
+                    s.blobs.append(note->pageBoundingRect());
+                }
+            }
+        }
+    }
+    return s;
+}
+
+//---------------------------------------------------------
+//   paintPageSummary
+//    level of detail drawing of the systems of page
+//    inside r (page coordinates)
+//---------------------------------------------------------
+
+void ScoreView::paintPageSummary(QPainter& p, Page* page, const QRectF& r)
+{
+    const QColor color(MScore::defaultColor);
+    QColor frameColor(color);
+    frameColor.setAlpha(40);
+    p.save();
+    for (const System* system : page->systems()) {
+        if (!system->pageBoundingRect().intersects(r)) {
+            continue;
+        }
+        const SystemSummary& s = systemSummary(system);
+        p.setPen(QPen(color, 0.0));
+        p.setBrush(Qt::NoBrush);
+        p.drawLines(s.lines);
+        p.setPen(Qt::NoPen);
+        p.setBrush(color);
+        p.drawRects(s.blobs);
+        p.setBrush(frameColor);
+        p.drawRects(s.frames);
+    }
+    p.restore();
+}
+
+//---------------------------------------------------------
+//   paintPageTiles
+//    draw the elements of page inside r (device coordinates)
+//    from cached tiles, rendering missing tiles first.
+//    Tiles are aligned to the integer part of the view
+//    offset, so scrolling keeps them valid. They cover
+//    the elements of the page, not only the page itself.
+//---------------------------------------------------------
+
+void ScoreView::paintPageTiles(QPainter& p, Page* page, const QRect& r)
+{
+    static const int TILE_SIZE = 256;
+
+    const qreal pixelRatio = devicePixelRatioF();
+    const QPoint fraction(lrint((_matrix.dx() - floor(_matrix.dx())) * 64),
+                          lrint((_matrix.dy() - floor(_matrix.dy())) * 64));
+    if (_pageTilesScale != _matrix.m11() || _pageTilesFraction != fraction || _pageTilesPixelRatio != pixelRatio) {
+        _pageTiles.clear();
+        _pageTilesScale      = _matrix.m11();
+        _pageTilesFraction   = fraction;
+        _pageTilesPixelRatio = pixelRatio;
+    }
+
+    const QPoint origin(int(floor(_matrix.dx())), int(floor(_matrix.dy())));
+    const QRect pr = _matrix.mapRect(pageElementBounds(page)).toAlignedRect().intersected(r);
+    if (pr.isEmpty()) {
+        return;
+    }
+    const int x1 = int(floor(qreal(pr.left() - origin.x()) / TILE_SIZE));
+    const int x2 = int(floor(qreal(pr.right() - origin.x()) / TILE_SIZE));
+    const int y1 = int(floor(qreal(pr.top() - origin.y()) / TILE_SIZE));
+    const int y2 = int(floor(qreal(pr.bottom() - origin.y()) / TILE_SIZE));
+
+    p.save();
+    p.resetTransform();
+    for (int y = y1; y <= y2; ++y) {
+        for (int x = x1; x <= x2; ++x) {
+            const QRect tr(origin + QPoint(x * TILE_SIZE, y * TILE_SIZE), QSize(TILE_SIZE, TILE_SIZE));
+            const PageTileKey key { page, x, y };
+            PageTile* tile = _pageTiles.object(key);
+            if (tile) {
+                p.drawPixmap(tr.topLeft(), tile->pm);
+                continue;
+            }
+            tile = new PageTile;
+            tile->canvasRect = imatrix.mapRect(QRectF(tr));
+            tile->pm = QPixmap(QSize(TILE_SIZE, TILE_SIZE) * pixelRatio);
+            tile->pm.setDevicePixelRatio(pixelRatio);
+            tile->pm.fill(Qt::transparent);
+
+            QPainter tp(&tile->pm);
+            tp.setRenderHint(QPainter::Antialiasing, preferences.getBool(PREF_UI_CANVAS_MISC_ANTIALIASEDDRAWING));
+            tp.setRenderHint(QPainter::TextAntialiasing, true);
+            tp.setTransform(_matrix * QTransform::fromTranslate(-tr.x(), -tr.y()));
+            tp.translate(page->pos());
+            QList<Element*> ell = page->items(tile->canvasRect.translated(-page->pos()));
+            drawElements(tp, ell, 0);
+            tp.end();
+
+            p.drawPixmap(tr.topLeft(), tile->pm);
+            _pageTiles.insert(key, tile, tile->pm.width() * tile->pm.height() * 4);
+        }
+    }
+    p.restore();
+}
+
 //---------------------------------------------------------
 //   paint
 //---------------------------------------------------------
@@ -1318,6 +1558,13 @@ void ScoreView::paint(const QRect& r, QPainter& p)
             drawElements(p, ell, editElement);
         }
     } else {
+        bool useTiles = pageTilesUsable();
+#ifdef AVSOMR
+        useTiles = useTiles && !omrDrawCtx;
+#endif
+        // below this on-screen staff space size notes are drawn as blobs
+        const qreal lodSpatium = preferences.getDouble(PREF_UI_CANVAS_MISC_LEVELOFDETAILSPATIUM);
+        const bool levelOfDetail = useTiles && _score->spatium() * _matrix.m11() < lodSpatium;
         for (Page* page : _score->pages()) {
             QRectF pr(page->abbox().translated(page->pos()));
             if (pr.right() < fr.left()) {
@@ -1330,6 +1577,18 @@ void ScoreView::paint(const QRect& r, QPainter& p)
             if (!score()->printing()) {
                 paintPageBorder(p, page);
             }
+            if (levelOfDetail) {
+                p.translate(page->pos());
+                paintPageSummary(p, page, fr.translated(-page->pos()));
+                p.translate(-page->pos());
+                r1 -= _matrix.mapRect(pr).toAlignedRect();
+                continue;
+            }
+            if (useTiles) {
+                paintPageTiles(p, page, r);
+                r1 -= _matrix.mapRect(pr).toAlignedRect();
+                continue;
+            }
             QList<Element*> ell = page->items(fr.translated(-page->pos()));
             QPointF pos(page->pos());
             p.translate(pos);
@@ -121,6 +121,43 @@ enum class ViewState {
     FOTO_LASSO,
 };
 
+//---------------------------------------------------------
+//   PageTile
+//    rendered elements of one page inside a square of the
+//    view, kept while only the view offset changes
+//---------------------------------------------------------
+
+struct PageTileKey {
+    const Page* page;
+    int x;
+    int y;
+    bool operator==(const PageTileKey& k) const { return page == k.page && x == k.x && y == k.y; }
+};
+
+inline uint qHash(const PageTileKey& k, uint seed = 0)
+{
+    return qHash(k.page, seed) ^ (uint(k.x) << 16) ^ uint(k.y);
+}
+
+struct PageTile {
+    QPixmap pm;
+    QRectF canvasRect;
+};
+
+//---------------------------------------------------------
+//   SystemSummary
+//    simplified drawing of a system for small zoom levels:
+//    staff and bar lines, notes as blobs and frames as
+//    boxes, in page coordinates
+//---------------------------------------------------------
+
+struct SystemSummary {
+    QRectF canvasRect;
+    QVector<QLineF> lines;
+    QVector<QRectF> blobs;
+    QVector<QRectF> frames;
+};
+
 //---------------------------------------------------------
 //   ScoreView
 //---------------------------------------------------------
@@ -195,6 +232,13 @@ class ScoreView : public QWidget, public MuseScoreView
     QPixmap* _bgPixmap;
     QPixmap* _fgPixmap;
 
+    QCache<PageTileKey, PageTile> _pageTiles;
+    qreal _pageTilesScale { 0.0 };        // zoom, subpixel offset and pixel ratio
+    QPoint _pageTilesFraction;            // the cached tiles were rendered with
+    qreal _pageTilesPixelRatio { 0.0 };
+    QHash<const System*, SystemSummary> _systemSummaries;
+    QHash<const Page*, QRectF> _pageElementBounds;    // canvas coordinates
+
     // By default when the view will prevent viewpoint changes if
     // it is inactive. Set this flag to true to change this behaviour.
     bool _moveWhenInactive = false;
@@ -211,6 +255,7 @@ class ScoreView : public QWidget, public MuseScoreView
 
     virtual bool event(QEvent* event) override;
     virtual bool gestureEvent(QGestureEvent*);              // ??
+    virtual void showEvent(QShowEvent*) override;
     virtual void resizeEvent(QResizeEvent*) override;
     virtual void dragEnterEvent(QDragEnterEvent*) override;
     virtual void dragLeaveEvent(QDragLeaveEvent*) override;
@@ -242,6 +287,13 @@ class ScoreView : public QWidget, public MuseScoreView
 
     void setShadowNote(const QPointF&);
     void drawElements(QPainter& p,QList<Element*>& el, Element* editElement);
+    bool pageTilesUsable() const;
+    void paintPageTiles(QPainter& p, Page* page, const QRect& r);
+    void invalidatePageTiles(const QRectF&);
+    void invalidatePageTiles() { _pageTiles.clear(); _systemSummaries.clear(); _pageElementBounds.clear(); }
+    QRectF pageElementBounds(Page* page);
+    const SystemSummary& systemSummary(const System*);
+    void paintPageSummary(QPainter& p, Page* page, const QRectF& r);
     bool dragTimeAnchorElement(const QPointF& pos);
     bool dragMeasureAnchorElement(const QPointF& pos);
     virtual void lyricsTab(bool back, bool end, bool moveOnly) override;
@@ -369,6 +421,7 @@ public:
     Page* addPage();
     virtual void setScore(Score* s);
     virtual void removeScore() { _score = 0; }
+    virtual bool isDisplayed() const override { return isVisible(); }
 
     void setMag(qreal m);
     bool navigatorVisible() const;
@@ -461,7 +514,7 @@ public:
 
     virtual void layoutChanged();
     virtual void dataChanged(const QRectF&);
-    virtual void updateAll() { update(); }
+    virtual void updateAll() { invalidatePageTiles(); update(); }
     virtual void adjustCanvasPosition(const Element* el, bool playBack, int staff = -1) override;
     virtual void setCursor(const QCursor& c) { QWidget::setCursor(c); }
     virtual QCursor cursor() const { return QWidget::cursor(); }
@@ -1066,6 +1066,30 @@ void Seq::initInstruments(bool realTime)
     }
 }
 
+//---------------------------------------------------------
+//   setPlaylistChanged
+//    remember which part of the score has changed, only
+//    the chunks overlapping it get rendered again
+//---------------------------------------------------------
+
+void Seq::setPlaylistChanged()
+{
+    if (playlistChanged) {
+        return;
+    }
+    const int tick1 = cs->playlistStartTick().ticks();
+    const int tick2 = cs->playlistEndTick().ticks();
+    if (!cs->playlistDirty() || tick1 < 0) {
+        playlistChanged = true;
+    } else if (changedTick1 < 0) {
+        changedTick1 = tick1;
+        changedTick2 = tick2;
+    } else {
+        changedTick1 = qMin(changedTick1, tick1);
+        changedTick2 = qMax(changedTick2, tick2);
+    }
+}
+
 //---------------------------------------------------------
 //   renderChunk
 //---------------------------------------------------------
@@ -1076,8 +1100,110 @@ void Seq::renderChunk(const MidiRenderer::Chunk& ch, EventMap* eventMap)
     MidiRenderer::Context ctx(synState);
     ctx.metronome = true;
     ctx.renderHarmony = preferences.getBool(PREF_SCORE_HARMONY_PLAY);
-    midi.renderChunk(ch, eventMap, ctx);
+    EventMap chunkEvents;
+    midi.renderChunk(ch, &chunkEvents, ctx);
+    eventMap->insert(chunkEvents.begin(), chunkEvents.end());
     renderEventsStatus.setOccupied(ch.utick1(), ch.utick2());
+    renderedChunks[ch.utick1()] = { ch.utick2(), std::move(chunkEvents) };
+}
+
+//---------------------------------------------------------
+//   repeatListState
+//    positions of the repeat segments, rendered events
+//    are only valid as long as these don't change
+//---------------------------------------------------------
+
+std::vector<int> Seq::repeatListState() const
+{
+    std::vector<int> state;
+    for (const RepeatSegment* rs : cs->repeatList()) {
+        state.push_back(rs->tick);
+        state.push_back(rs->utick);
+        state.push_back(rs->len());
+    }
+    return state;
+}
+
+//---------------------------------------------------------
+//   invalidateChunks
+//    remove the events of all rendered chunks overlapping
+//    the score ticks tick1 - tick2 so that they get rendered
+//    again. Returns false if the playlist has to be rendered
+//    from scratch.
+//---------------------------------------------------------
+
+bool Seq::invalidateChunks(int tick1, int tick2)
+{
+    midi.setScoreChanged();
+    if (repeatListState() != renderedRepeats) {
+        return false;
+    }
+
+    for (const RepeatSegment* rs : cs->repeatList()) {
+        const int t1 = qMax(tick1, rs->tick);
+        const int t2 = qMin(tick2, rs->tick + rs->len());
+        if (t1 > t2 || t1 == rs->tick + rs->len()) {
+            continue;
+        }
+        const int tickOffset = rs->utick - rs->tick;
+        int utick1 = t1 + tickOffset;
+        int utick2 = qMax(t2 + tickOffset, utick1 + 1);
+
+        // The chunk partition may have changed with the score,
+        // extend the range until it matches both the current
+        // chunks and the ones the events were rendered for.
+        bool extended = true;
+        while (extended) {
+            extended = false;
+            for (int utick = utick1; utick < utick2;) {
+                const MidiRenderer::Chunk ch = midi.getChunkAt(utick);
+                if (!ch) {
+                    break;
+                }
+                if (ch.utick1() < utick1) {
+                    utick1 = ch.utick1();
+                    extended = true;
+                }
+                if (ch.utick2() > utick2) {
+                    utick2 = ch.utick2();
+                    extended = true;
+                }
+                utick = ch.utick2();
+            }
+            auto i = renderedChunks.lower_bound(utick1);
+            if (i != renderedChunks.begin() && std::prev(i)->second.utick2 > utick1) {
+                --i;
+            }
+            for (; i != renderedChunks.end() && i->first < utick2; ++i) {
+                if (i->first < utick1) {
+                    utick1 = i->first;
+                    extended = true;
+                }
+                if (i->second.utick2 > utick2) {
+                    utick2 = i->second.utick2;
+                    extended = true;
+                }
+            }
+        }
+
+        // Remove exactly the events rendered for these chunks,
+        // note offs of tied notes may lie far beyond the chunk.
+        auto i = renderedChunks.lower_bound(utick1);
+        while (i != renderedChunks.end() && i->first < utick2) {
+            for (const auto& e : i->second.events) {
+                auto range = events.equal_range(e.first);
+                for (auto ie = range.first; ie != range.second; ++ie) {
+                    if (ie->second == e.second && ie->second.note() == e.second.note()) {
+                        events.erase(ie);
+                        break;
+                    }
+                }
+            }
+            i = renderedChunks.erase(i);
+        }
+        renderEventsStatus.setUnoccupied(utick1, utick2);
+    }
+    return true;
 }
 
 //---------------------------------------------------------
@@ -1098,7 +1224,7 @@ void Seq::updateEventsEnd()
 void Seq::collectEvents(int utick)
 {
     //do not collect even while playing
-    if (state == Transport::PLAY && playlistChanged) {
+    if (state == Transport::PLAY && (playlistChanged || changedTick1 >= 0)) {
         return;
     }
 
@@ -1108,15 +1234,22 @@ void Seq::collectEvents(int utick)
         midiRenderFuture.waitForFinished();
     }
 
+    if (!renderEvents.empty()) {
+        events.insert(renderEvents.begin(), renderEvents.end());
+        renderEvents.clear();
+    }
+    if (!playlistChanged && changedTick1 >= 0) {
+        playlistChanged = !invalidateChunks(changedTick1, changedTick2);
+    }
     if (playlistChanged) {
         midi.setScoreChanged();
         events.clear();
-        renderEvents.clear();
         renderEventsStatus.clear();
-    } else if (!renderEvents.empty()) {
-        events.insert(renderEvents.begin(), renderEvents.end());
-        renderEvents.clear();
+        renderedChunks.clear();
+        renderedRepeats = repeatListState();
     }
+    changedTick1 = -1;
+    changedTick2 = -1;
 
     int unrenderedUtick = renderEventsStatus.occupiedRangeEnd(utick);
     while (unrenderedUtick - utick < minUtickBufferSize) {
@@ -129,6 +129,8 @@ class Seq : public QObject, public Sequencer
 
     bool oggInit;
     bool playlistChanged;
+    int changedTick1 { -1 };              // score tick range changed since last collectEvents,
+    int changedTick2 { -1 };              // -1 if none
 
     SeqMsgFifo toSeq;
     SeqMsgFifo fromSeq;
@@ -143,6 +145,12 @@ class Seq : public QObject, public Sequencer
     EventMap::const_iterator eventsEnd;
     EventMap renderEvents;                // event list that is rendered in background
     RangeMap renderEventsStatus;
+    struct RenderedChunk {
+        int utick2;
+        EventMap events;
+    };
+    std::map<int, RenderedChunk> renderedChunks;   // events rendered per chunk, by start utick
+    std::vector<int> renderedRepeats;              // repeat list rendered chunks are based on
     MidiRenderer midi;
     QFuture<void> midiRenderFuture;
     bool allowBackgroundRendering = false;   // should be set to true only when playing, so no
@@ -194,6 +202,8 @@ class Seq : public QObject, public Sequencer
     void stopTransport();
 
     void renderChunk(const MidiRenderer::Chunk&, EventMap*);
+    std::vector<int> repeatListState() const;
+    bool invalidateChunks(int tick1, int tick2);
     void updateEventsEnd();
 
     void setPos(int);
@@ -213,7 +223,7 @@ private slots:
     void seqMessage(int msg, int arg = 0);
     void heartBeatTimeout();
     void midiInputReady();
-    void setPlaylistChanged() { playlistChanged = true; }
+    void setPlaylistChanged();
     void handleTimeSigTempoChanged();
 
 public slots:
@@ -186,9 +186,7 @@ public:
     QTextStream* stream;
     int resolution;
 
-    QString header;
 //    QString defs; // NEEDED FOR GRADIENTS
-    QString body;
 
     QBrush brush;
     QPen pen;
@@ -248,7 +246,18 @@ protected:
 // The Ms::Element being generated right now
     const Ms::Element* _element = NULL;
 
+// Path reuse, see SvgGenerator::setReusePaths()
+    bool _reusePaths { false };
+    bool _fillOnly   { false };   // current state fills without stroking
+    bool _batchable  { false };   // current state strokes opaque lines without filling
+    QHash<QString, int> _pathDefs; // path data relative to its first point -> <defs> id
+    QString _batchState;          // attributes of the pending batched <path>
+    QString _batchData;           // its path data
+
     void writeImage(const QRectF& r, const QByteArray& imageData, const QString& mimeFormat);
+    void writePathData(QTextStream& s, const QPainterPath& p, qreal dx, qreal dy);
+    bool drawReusedPath(const QPainterPath& p);
+    void flushBatch();
 
 // SVG strings as constants
 #define SVG_SPACE    ' '
@@ -295,6 +304,12 @@ protected:
 #define SVG_IMAGE       "<image"
 #define SVG_PATH        "<path"
 #define SVG_POLYLINE    "<polyline"
+#define SVG_USE         "<use"
+#define SVG_DEFS_BEGIN  "<defs>"
+#define SVG_DEFS_END    "</defs>"
+
+#define SVG_ID          " id=\"p"
+#define SVG_HREF        " xlink:href=\"#p"
 
 #define SVG_PRESERVE_ASPECT " preserveAspectRatio=\""
 
@@ -373,6 +388,13 @@ public:
         d_func()->outputDevice = device;
     }
 
+    bool reusePaths() const { return _reusePaths; }
+    void setReusePaths(bool val)
+    {
+        Q_ASSERT(!isActive());
+        _reusePaths = val;
+    }
+
     int resolution() { return d_func()->resolution; }
     void setResolution(int resolution)
     {
@@ -964,6 +986,31 @@ void SvgGenerator::setResolution(int dpi)
     d->engine->setResolution(dpi);
 }
 
+/*!
+    \property SvgGenerator::reusePaths
+    \brief whether repeated glyph outlines are written once and referenced
+
+    When set, filled outlines with curves (glyphs) are written to
+    \c<defs> once and drawn with \c<use>, and consecutive opaque
+    strokes with the same attributes are written as a single \c<path>.
+    By default this property is \c false.
+*/
+bool SvgGenerator::reusePaths() const
+{
+    Q_D(const SvgGenerator);
+    return d->engine->reusePaths();
+}
+
+void SvgGenerator::setReusePaths(bool val)
+{
+    Q_D(SvgGenerator);
+    if (d->engine->isActive()) {
+        qWarning("SvgGenerator::setReusePaths(), cannot set reusePaths while SVG is being generated");
+        return;
+    }
+    d->engine->setReusePaths(val);
+}
+
 /*!
     Returns the paint engine used to render graphics to be converted to SVG
     format information.
@@ -1046,8 +1093,16 @@ bool SvgPaintEngine::begin(QPaintDevice*)
         return false;
     }
 
-    // Stream the headers
-    d->stream = new QTextStream(&d->header);
+    // Stream straight to the device, the <defs> of reused paths
+    // are written where they are first used
+    d->stream = new QTextStream(d->outputDevice);
+#ifndef QT_NO_TEXTCODEC
+    d->stream->setCodec(QTextCodec::codecForName("UTF-8"));
+#endif
+    _pathDefs.clear();
+    _batchState.clear();
+    _batchData.clear();
+
     stream() << "<?xml version=\"1.0\" encoding=\"UTF-8\" standalone=\"no\"?>" << endl << SVG_BEGIN;
     if (d->viewBox.isValid()) {
         // viewBox has floating point values, size width/height is integer
@@ -1073,8 +1128,6 @@ bool SvgPaintEngine::begin(QPaintDevice*)
 //    d->stream->setString(&d->defs);
 //    *d->stream << "<defs>\n";
 
-    // Point the stream at the body string, for other functions to populate
-    d->stream->setString(&d->body);
     return true;
 }
 
@@ -1086,17 +1139,7 @@ bool SvgPaintEngine::end()
 //    d->stream->setString(&d->defs);
 //    stream() << "</defs>\n";
 
-    // Point the stream at the real output device (the .svg file)
-    d->stream->setDevice(d->outputDevice);
-
-#ifndef QT_NO_TEXTCODEC
-    d->stream->setCodec(QTextCodec::codecForName("UTF-8"));
-#endif
-
-    // Stream our strings out to the device, in order
-    stream() << d->header;
-//    stream() << d->defs;
-    stream() << d->body;
+    flushBatch();
     stream() << SVG_END << endl;
 
     delete d->stream;
@@ -1149,6 +1192,7 @@ void SvgPaintEngine::drawImage(const QRectF& r, const QImage& image,
 
 void SvgPaintEngine::writeImage(const QRectF& r, const QByteArray& imageData, const QString& mimeFormat)
 {
+    flushBatch();
     stream() << SVG_IMAGE << stateString
              << SVG_X << SVG_QUOTE << r.x() + _dx << SVG_QUOTE
              << SVG_Y << SVG_QUOTE << r.y() + _dy << SVG_QUOTE
@@ -1182,6 +1226,10 @@ void SvgPaintEngine::updateState(const QPaintEngineState& s)
         stateStream << SVG_OPACITY << s.opacity() << SVG_QUOTE;
     }
 
+    _fillOnly  = _reusePaths && s.brush().style() == Qt::SolidPattern && s.pen().style() == Qt::NoPen;
+    _batchable = _reusePaths && s.brush().style() == Qt::NoBrush && s.pen().style() == Qt::SolidLine
+                 && s.pen().color().alpha() == 255 && qFuzzyIsNull(s.opacity() - 1);
+
     // Translations, SVG transform="translate()", are handled separately from
     // other transformations such as rotation. Qt translates everything, but
     // other transformations do occur, and must be handled here.
@@ -1214,6 +1262,24 @@ void SvgPaintEngine::updateState(const QPaintEngineState& s)
 
 void SvgPaintEngine::drawPath(const QPainterPath& p)
 {
+    if (_fillOnly && drawReusedPath(p)) {
+        return;
+    }
+    if (_batchable) {
+        // Consecutive opaque strokes with the same attributes, like staff lines
+        // and stems, are drawn the same as subpaths of a single <path>
+        if (stateString != _batchState) {
+            flushBatch();
+            _batchState = stateString;
+        } else {
+            _batchData += SVG_SPACE;
+        }
+        QTextStream s(&_batchData);
+        writePathData(s, p, _dx, _dy);
+        return;
+    }
+    flushBatch();
+
     stream() << SVG_PATH << stateString;
 
     // fill-rule is here because UpdateState() doesn't have a QPainterPath arg
@@ -1224,25 +1290,31 @@ void SvgPaintEngine::drawPath(const QPainterPath& p)
 
     // Path data
     stream() << SVG_D;
+    writePathData(stream(), p, _dx, _dy);
+    stream() << SVG_QUOTE << SVG_ELEMENT_END << endl;
+}
+
+void SvgPaintEngine::writePathData(QTextStream& s, const QPainterPath& p, qreal dx, qreal dy)
+{
     for (int i = 0; i < p.elementCount(); ++i) {
         const QPainterPath::Element& e = p.elementAt(i);
-        qreal x = e.x + _dx;
-        qreal y = e.y + _dy;
+        qreal x = e.x + dx;
+        qreal y = e.y + dy;
         switch (e.type) {
         case QPainterPath::MoveToElement:
-            stream() << SVG_MOVE << x << SVG_COMMA << y;
+            s << SVG_MOVE << x << SVG_COMMA << y;
             break;
         case QPainterPath::LineToElement:
-            stream() << SVG_LINE << x << SVG_COMMA << y;
+            s << SVG_LINE << x << SVG_COMMA << y;
             break;
         case QPainterPath::CurveToElement:
-            stream() << SVG_CURVE << x << SVG_COMMA << y;
+            s << SVG_CURVE << x << SVG_COMMA << y;
             ++i;
             while (i < p.elementCount()) {
                 const QPainterPath::Element& ee = p.elementAt(i);
                 if (ee.type == QPainterPath::CurveToDataElement) {
-                    stream() << SVG_SPACE << ee.x + _dx
-                             << SVG_COMMA << ee.y + _dy;
+                    s << SVG_SPACE << ee.x + dx
+                      << SVG_COMMA << ee.y + dy;
                     ++i;
                 } else {
                     --i;
@@ -1254,10 +1326,71 @@ void SvgPaintEngine::drawPath(const QPainterPath& p)
             break;
         }
         if (i <= p.elementCount() - 1) {
-            stream() << SVG_SPACE;
+            s << SVG_SPACE;
         }
     }
-    stream() << SVG_QUOTE << SVG_ELEMENT_END << endl;
+}
+
+//---------------------------------------------------------
+//   drawReusedPath
+//    Filled outlines with curves (glyphs drawn as text) are
+//    written once to <defs>, relative to their first point,
+//    and drawn by <use>. Returns false for other paths.
+//---------------------------------------------------------
+
+bool SvgPaintEngine::drawReusedPath(const QPainterPath& p)
+{
+    bool curved = false;
+    for (int i = 0; i < p.elementCount(); ++i) {
+        if (p.elementAt(i).type == QPainterPath::CurveToElement) {
+            curved = true;
+            break;
+        }
+    }
+    if (!curved) {
+        return false;
+    }
+    const QPainterPath::Element& first = p.elementAt(0);
+    QString data;
+    {
+        QTextStream s(&data);
+        writePathData(s, p, -first.x, -first.y);
+    }
+    if (p.fillRule() == Qt::OddEvenFill) {
+        data += SVG_SPACE;            // keep both fill rules apart
+    }
+
+    flushBatch();
+    int id = _pathDefs.value(data);
+    if (!id) {
+        id = _pathDefs.size() + 1;
+        _pathDefs.insert(data, id);
+        stream() << SVG_DEFS_BEGIN << SVG_PATH << SVG_ID << id << SVG_QUOTE;
+        if (p.fillRule() == Qt::OddEvenFill) {
+            stream() << SVG_FILL_RULE;
+        }
+        stream() << SVG_D << data.trimmed() << SVG_QUOTE << SVG_ELEMENT_END << SVG_DEFS_END << endl;
+    }
+    stream() << SVG_USE << SVG_HREF << id << SVG_QUOTE << stateString
+             << SVG_X << SVG_QUOTE << first.x + _dx << SVG_QUOTE
+             << SVG_Y << SVG_QUOTE << first.y + _dy << SVG_QUOTE
+             << SVG_ELEMENT_END << endl;
+    return true;
+}
+
+//---------------------------------------------------------
+//   flushBatch
+//    write the pending batched <path>, if any
+//---------------------------------------------------------
+
+void SvgPaintEngine::flushBatch()
+{
+    if (_batchData.isEmpty()) {
+        return;
+    }
+    stream() << SVG_PATH << _batchState << SVG_D << _batchData << SVG_QUOTE << SVG_ELEMENT_END << endl;
+    _batchState.clear();
+    _batchData.clear();
 }
 
 void SvgPaintEngine::drawPolygon(const QPointF* points, int pointCount,
@@ -1271,6 +1404,7 @@ void SvgPaintEngine::drawPolygon(const QPointF* points, int pointCount,
     }
 
     if (mode == PolylineMode) {
+        flushBatch();
         stream() << SVG_POLYLINE << stateString
                  << SVG_POINTS;
         for (int i = 0; i < pointCount; ++i) {
@@ -13,7 +13,13 @@
 #include <QtTest/QtTest>
 
 #include "libmscore/score.h"
+#include "libmscore/bend.h"
 #include "libmscore/element.h"
+#include "libmscore/segment.h"
+#include "libmscore/sym.h"
+#include "libmscore/text.h"
+#include "libmscore/textmetrics.h"
+#include "libmscore/undo.h"
 #include "mtest/testutils.h"
 
 using namespace Ms;
@@ -29,6 +35,12 @@ class TestElement : public QObject, public MTest
 private slots:
     void initTestCase() { initMTest(); }
     void testIds();
+    void undoCoalesce();
+    void undoMemoryLimit();
+    void bulkChangeProperty();
+    void glyphCache();
+    void textMetrics();
+    void readSharedPropertyName();
 };
 
 //---------------------------------------------------------
@@ -104,6 +116,193 @@ void TestElement::testIds()
     }
 }
 
+//---------------------------------------------------------
+//   undoCoalesce
+//    repeated changes of a property in one command are
+//    kept as a single undo command
+//---------------------------------------------------------
+
+void TestElement::undoCoalesce()
+{
+    MasterScore* s = readScore("test.mscx");
+    QVERIFY(s);
+    Element* e = s->firstSegment(SegmentType::ChordRest)->element(0);
+    QVERIFY(e);
+    const QColor color = e->color();
+
+    s->startCmd();
+    e->undoChangeProperty(Pid::COLOR, QColor(Qt::red));
+    const int n = s->undoStack()->current()->childCount();
+    e->undoChangeProperty(Pid::COLOR, QColor(Qt::green));
+    e->undoChangeProperty(Pid::COLOR, QColor(Qt::blue));
+    QCOMPARE(s->undoStack()->current()->childCount(), n);
+    s->endCmd();
+    QCOMPARE(e->color(), QColor(Qt::blue));
+
+    s->undoStack()->undo(0);
+    QCOMPARE(e->color(), color);
+    s->undoStack()->redo(0);
+    QCOMPARE(e->color(), QColor(Qt::blue));
+    delete s;
+}
+
+//---------------------------------------------------------
+//   undoMemoryLimit
+//    the oldest commands are dropped when the undo stack
+//    holds more than MScore::undoMemoryLimit bytes
+//---------------------------------------------------------
+
+void TestElement::undoMemoryLimit()
+{
+    MasterScore* s = readScore("test.mscx");
+    QVERIFY(s);
+    Element* e = s->firstSegment(SegmentType::ChordRest)->element(0);
+    QVERIFY(e);
+    UndoStack* undo = s->undoStack();
+    QCOMPARE(undo->memoryUsed(), size_t(0));
+
+    for (int i = 0; i < 4; ++i) {
+        s->startCmd();
+        e->undoChangeProperty(Pid::VISIBLE, !e->visible());
+        s->endCmd();
+    }
+    QCOMPARE(undo->getCurIdx(), 4);
+    const size_t used = undo->memoryUsed();
+    QVERIFY(used > 0);
+
+    MScore::undoMemoryLimit = used / 2;
+    s->startCmd();
+    e->undoChangeProperty(Pid::VISIBLE, !e->visible());
+    s->endCmd();
+    MScore::undoMemoryLimit = 0;
+
+    QCOMPARE(undo->getCurIdx(), 5);
+    QVERIFY(undo->memoryUsed() <= used / 2);
+    int undoable = 0;
+    while (undo->canUndo()) {
+        undo->undo(0);
+        ++undoable;
+    }
+    QVERIFY(undoable >= 1 && undoable < 5);
+    QVERIFY(undo->memoryUsed() > 0);        // redo stack
+    delete s;
+}
+
+//---------------------------------------------------------
+//   bulkChangeProperty
+//    a bulk edit keeps all changes in one undo command
+//---------------------------------------------------------
+
+void TestElement::bulkChangeProperty()
+{
+    MasterScore* s = readScore("test.mscx");
+    QVERIFY(s);
+    std::vector<Element*> el;
+    for (Segment* seg = s->firstSegment(SegmentType::ChordRest); seg; seg = seg->next1(SegmentType::ChordRest)) {
+        if (seg->element(0)) {
+            el.push_back(seg->element(0));
+        }
+    }
+    QVERIFY(el.size() > 1);
+    el.push_back(el.front());                 // duplicates are changed once
+    std::vector<QColor> colors;
+    for (Element* e : el) {
+        colors.push_back(e->color());
+    }
+
+    s->startCmd();
+    s->undoChangeProperties(el, Pid::COLOR, QColor(Qt::red));
+    QCOMPARE(s->undoStack()->current()->childCount(), 1);
+    s->endCmd();
+    for (Element* e : el) {
+        QCOMPARE(e->color(), QColor(Qt::red));
+    }
+
+    s->undoStack()->undo(0);
+    for (size_t i = 0; i < el.size(); ++i) {
+        QCOMPARE(el[i]->color(), colors[i]);
+    }
+    s->undoStack()->redo(0);
+    for (Element* e : el) {
+        QCOMPARE(e->color(), QColor(Qt::red));
+    }
+    delete s;
+}
+
+//---------------------------------------------------------
+//   glyphCache
+//    nearby scales and different colors are served from
+//    the same cached glyph
+//---------------------------------------------------------
+
+void TestElement::glyphCache()
+{
+    ScoreFont* f = ScoreFont::fontFactory("Emmentaler");
+    QVERIFY(f);
+    QImage img(200, 200, QImage::Format_ARGB32_Premultiplied);
+    QPainter p(&img);
+    f->draw(SymId::noteheadBlack, &p, 1.0, QPointF(50, 50), 1.0);      // make sure the glyph is cached
+    f->resetCacheStatistics();
+
+    p.setPen(Qt::black);
+    f->draw(SymId::noteheadBlack, &p, 1.0, QPointF(50, 50), 1.0);
+    f->draw(SymId::noteheadBlack, &p, 1.0, QPointF(50, 50), 1.001);
+    p.setPen(Qt::red);
+    f->draw(SymId::noteheadBlack, &p, 1.0, QPointF(50, 50), 1.0);
+    QCOMPARE(f->cacheMisses(), 0);
+    QCOMPARE(f->cacheHits(), 3);
+
+    f->draw(SymId::noteheadBlack, &p, 1.0, QPointF(50, 50), 2.0);
+    QCOMPARE(f->cacheMisses(), 1);
+}
+
+//---------------------------------------------------------
+//   textMetrics
+//    cached text metrics must match a direct font metrics query
+//    and relayout of the same text must not add cache entries
+//---------------------------------------------------------
+
+void TestElement::textMetrics()
+{
+    TextMetrics::clear();
+    Text* text = new Text(score);
+    text->setPlainText("Allegro ma non troppo");
+    text->layout();
+
+    const QRectF bbox = text->bbox();
+    QVERIFY(TextMetrics::size() > 0);
+
+    QFont f = text->font();
+    QFontMetricsF fm(f, MScore::paintDevice());
+    QCOMPARE(TextMetrics::width(f, "Allegro"), fm.width("Allegro"));
+    QCOMPARE(TextMetrics::tightBoundingRect(f, "Allegro"), fm.tightBoundingRect("Allegro"));
+    QCOMPARE(TextMetrics::lineSpacing(f), fm.lineSpacing());
+
+    const int entries = TextMetrics::size();
+    text->layout();
+    QCOMPARE(text->bbox(), bbox);
+    QCOMPARE(TextMetrics::size(), entries);
+    delete text;
+}
+
+//---------------------------------------------------------
+//   readSharedPropertyName
+//    <size> is the tag of Pid::SIZE and Pid::FONT_SIZE;
+//    a styled font size must survive write and read
+//---------------------------------------------------------
+
+void TestElement::readSharedPropertyName()
+{
+    Bend* bend = new Bend(score);
+    bend->setProperty(Pid::FONT_SIZE, 15.0);
+    bend->setPropertyFlags(Pid::FONT_SIZE, PropertyFlags::UNSTYLED);
+    Element* e = writeReadElement(bend);
+    QVERIFY(e && e->isBend());
+    QCOMPARE(e->getProperty(Pid::FONT_SIZE).toReal(), 15.0);
+    delete bend;
+    delete e;
+}
+
 QTEST_MAIN(TestElement)
 
 #include "tst_element.moc"
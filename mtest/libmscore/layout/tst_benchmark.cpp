@@ -13,6 +13,12 @@
 #include <QtTest/QtTest>
 #include "mtest/testutils.h"
 #include "libmscore/score.h"
+#include "libmscore/excerpt.h"
+#include "libmscore/segment.h"
+#include "libmscore/property.h"
+#include "libmscore/style.h"
+#include "libmscore/page.h"
+#include "libmscore/pagerender.h"
 
 #define DIR QString("libmscore/layout/")
 
@@ -31,14 +37,25 @@ class TestBenchmark : public QObject, public MTest
     Q_OBJECT
 
     MasterScore * score;
+    QList<MasterScore*> vtestScores;
+    QList<QByteArray> vtestHashes;
     void beam(const char* path);
 
 private slots:
     void initTestCase();
+    void cleanupTestCase();
     void benchmark3();
     void benchmark1();
     void benchmark2();
     void benchmark4();              // incremental layout (one page)
+    void benchmarkRead();           // reading a large score
+    void benchmarkReadParts();      // reading linked part scores
+    void benchmarkStyleValues();    // style access as done by layout
+    void nameLookup();
+    void benchmarkRenderBands_data();
+    void benchmarkRenderBands();    // png rendering of the vtest set
+    void benchmarkPdf_data();
+    void benchmarkPdf();            // pdf export, serial vs. concurrent page recording
 };
 
 //---------------------------------------------------------
@@ -50,6 +67,11 @@ void TestBenchmark::initTestCase()
     initMTest();
 }
 
+void TestBenchmark::cleanupTestCase()
+{
+    qDeleteAll(vtestScores);
+}
+
 //---------------------------------------------------------
 //   benchmark
 //---------------------------------------------------------
@@ -90,5 +112,184 @@ void TestBenchmark::benchmark4()
     }
 }
 
+void TestBenchmark::benchmarkRead()
+{
+    QBENCHMARK {
+        MasterScore* s = readScore("libmscore/concertpitch/concertpitchbenchmark.mscx");
+        QVERIFY(s);
+        delete s;
+    }
+}
+
+//---------------------------------------------------------
+//   benchmarkReadParts
+//---------------------------------------------------------
+
+void TestBenchmark::benchmarkReadParts()
+{
+    QBENCHMARK {
+        MasterScore* s = readScore("libmscore/parts/part-all-appendmeasures.mscx");
+        QVERIFY(s);
+        QVERIFY(!s->excerpts().isEmpty());
+        Score* part = s->excerpts().front()->partScore();
+        Segment* seg = part->firstSegment(SegmentType::ChordRest);
+        QVERIFY(seg && seg->element(0) && seg->element(0)->links());
+        delete s;
+    }
+}
+
+void TestBenchmark::benchmarkStyleValues()
+{
+    MasterScore* s = readScore("libmscore/concertpitch/concertpitchbenchmark.mscx");
+    QVERIFY(s);
+    QCOMPARE(s->styleD(Sid::spatium), s->style().value(Sid::spatium).toDouble());
+    QCOMPARE(s->styleB(Sid::genClef), s->style().value(Sid::genClef).toBool());
+    QCOMPARE(s->styleI(Sid::minEmptyMeasures), s->style().value(Sid::minEmptyMeasures).toInt());
+
+    s->setStyleValue(Sid::genClef, false);
+    QCOMPARE(s->styleB(Sid::genClef), false);
+
+    qreal sum = 0.0;
+    QBENCHMARK {
+        for (int i = 0; i < 100000; ++i) {
+            sum += s->spatium() + s->styleP(Sid::staffDistance) + s->styleD(Sid::measureSpacing);
+            sum += s->styleB(Sid::genClef) + s->styleI(Sid::minEmptyMeasures);
+        }
+    }
+    QVERIFY(sum > 0.0);
+    delete s;
+}
+
+//---------------------------------------------------------
+//   nameLookup
+//    hashed lookup finds the first property/style of a name
+//---------------------------------------------------------
+
+void TestBenchmark::nameLookup()
+{
+    for (int i = 0; i < int(Pid::END); ++i) {
+        const QString name(propertyName(Pid(i)));
+        QCOMPARE(QString(propertyName(propertyId(name))), name);
+    }
+    QCOMPARE(propertyId(QString("noSuchProperty")), Pid::END);
+
+    for (int i = 0; i < int(Sid::STYLES); ++i) {
+        const QString name(MStyle::valueName(Sid(i)));
+        QCOMPARE(QString(MStyle::valueName(MStyle::styleIdx(name))), name);
+    }
+    QCOMPARE(MStyle::styleIdx(QString("noSuchStyle")), Sid::NOSTYLE);
+
+    QBENCHMARK {
+        for (int i = 0; i < int(Pid::END); ++i) {
+            propertyId(QString(propertyName(Pid(i))));
+        }
+    }
+}
+
+//---------------------------------------------------------
+//   imageHash
+//---------------------------------------------------------
+
+static QByteArray imageHash(const QImage& image)
+{
+    QCryptographicHash hash(QCryptographicHash::Md5);
+    for (int y = 0; y < image.height(); ++y) {
+        hash.addData(reinterpret_cast<const char*>(image.constScanLine(y)), image.width() * 4);
+    }
+    return hash.result();
+}
+
+//---------------------------------------------------------
+//   benchmarkRenderBands
+//    render the first page of the vtest scores at 300 dpi
+//    on one thread and in concurrent bands; both must give
+//    the same pixels
+//---------------------------------------------------------
+
+void TestBenchmark::benchmarkRenderBands_data()
+{
+    QTest::addColumn<int>("threads");
+
+    QTest::newRow("serial") << 1;
+    QTest::newRow("bands") << QThread::idealThreadCount();
+}
+
+void TestBenchmark::benchmarkRenderBands()
+{
+    QFETCH(int, threads);
+
+    if (vtestScores.isEmpty()) {
+        const QString dir = root + "/../vtest/";
+        for (const QString& file : QDir(dir).entryList({ "*.mscx" }, QDir::Files, QDir::Name)) {
+            MasterScore* s = readCreatedScore(dir + file);
+            if (!s) {
+                continue;
+            }
+            s->doLayout();
+            if (s->pages().isEmpty()) {
+                delete s;
+                continue;
+            }
+            vtestScores.append(s);
+        }
+    }
+    QVERIFY(!vtestScores.isEmpty());
+
+    QThreadPool* pool = QThreadPool::globalInstance();
+    const int maxThreads = pool->maxThreadCount();
+    pool->setMaxThreadCount(threads);
+    QList<QByteArray> hashes;
+    QBENCHMARK {
+        hashes.clear();
+        for (MasterScore* s : vtestScores) {
+            hashes.append(imageHash(PageRender::image(s->pages().front(), 300.0)));
+        }
+    }
+    pool->setMaxThreadCount(maxThreads);
+
+    if (vtestHashes.isEmpty()) {
+        vtestHashes = hashes;
+        return;
+    }
+    for (int i = 0; i < vtestScores.size(); ++i) {
+        QVERIFY2(hashes[i] == vtestHashes[i], qPrintable(vtestScores[i]->fileInfo()->completeBaseName()));
+    }
+}
+
+//---------------------------------------------------------
+//   benchmarkPdf
+//    pdf export of a multi-page score with its pages
+//    recorded on one thread and on the pool; playback into
+//    the pdf stream is serial in both rows
+//---------------------------------------------------------
+
+void TestBenchmark::benchmarkPdf_data()
+{
+    QTest::addColumn<int>("threads");
+
+    QTest::newRow("serial") << 1;
+    QTest::newRow("concurrent") << QThread::idealThreadCount();
+}
+
+void TestBenchmark::benchmarkPdf()
+{
+    QFETCH(int, threads);
+
+    MasterScore* s = readScore("libmscore/concertpitch/concertpitchbenchmark.mscx");
+    QVERIFY(s);
+    s->doLayout();
+
+    QThreadPool* pool = QThreadPool::globalInstance();
+    const int maxThreads = pool->maxThreadCount();
+    pool->setMaxThreadCount(threads);
+    QBENCHMARK {
+        QBuffer buffer;
+        buffer.open(QIODevice::WriteOnly);
+        QVERIFY(PageRender::pdf({ s }, &buffer, 300, "benchmarkPdf"));
+    }
+    pool->setMaxThreadCount(maxThreads);
+    delete s;
+}
+
 QTEST_MAIN(TestBenchmark)
 #include "tst_benchmark.moc"
@@ -23,6 +23,7 @@
 #include "libmscore/chord.h"
 #include "libmscore/note.h"
 #include "libmscore/keysig.h"
+#include "libmscore/rendermidi.h"
 #include "audio/exports/exportmidi.h"
 #include <QIODevice>
 
@@ -80,6 +81,8 @@ private slots:
     void midiTimeStretchFermataTempoEdit();
     void midiTimeStretchFermataTempoEditContinuousView();
     void midiSingleNoteDynamics();
+    void midiPlaylistRange();
+    void renderStatusUnoccupied();
 };
 
 //---------------------------------------------------------
@@ -528,6 +531,72 @@ void TestMidi::midiSingleNoteDynamics()
     delete score;
 }
 
+//---------------------------------------------------------
+//   midiPlaylistRange
+//    edits only mark the playlist range they affect as dirty
+//---------------------------------------------------------
+
+void TestMidi::midiPlaylistRange()
+{
+    MasterScore* score = readScore(DIR + "testSingleNoteDynamics.mscx");
+    QVERIFY(score);
+    score->doLayout();
+
+    Measure* m = score->firstMeasure()->nextMeasure();
+    Chord* chord = toChord(m->findChordRest(m->tick(), 0));
+    QVERIFY(chord);
+    Note* note = chord->upNote();
+
+    // a pitch change invalidates the note only
+    score->setPlaylistClean();
+    score->startCmd();
+    note->undoChangeProperty(Pid::PITCH, note->pitch() + 1);
+    QVERIFY(score->playlistDirty());
+    QCOMPARE(score->playlistStartTick(), chord->tick());
+    QCOMPARE(score->playlistEndTick(), chord->tick() + chord->actualTicks());
+    score->endCmd();
+    QVERIFY(score->playlistDirty());
+    QCOMPARE(score->playlistStartTick(), chord->tick());
+
+    // a dynamic changes the velocity up to the end of the score
+    Element* dynamic = m->first(SegmentType::ChordRest)->findAnnotation(ElementType::DYNAMIC, 0, 0);
+    QVERIFY(dynamic);
+    score->setPlaylistClean();
+    score->startCmd();
+    score->undoRemoveElement(dynamic);
+    QCOMPARE(score->playlistStartTick(), m->tick());
+    QCOMPARE(score->playlistEndTick(), score->endTick());
+    score->endCmd();
+
+    // changes to the whole score invalidate the whole playlist
+    score->setPlaylistClean();
+    score->setPlaylistDirty();
+    QCOMPARE(score->playlistStartTick(), Fraction(-1, 1));
+
+    delete score;
+}
+
+//---------------------------------------------------------
+//   renderStatusUnoccupied
+//---------------------------------------------------------
+
+void TestMidi::renderStatusUnoccupied()
+{
+    RangeMap status;
+    status.setOccupied(0, 480);
+    status.setOccupied(480, 960);
+    status.setUnoccupied(240, 720);
+    QCOMPARE(status.occupiedRangeEnd(0), 240);
+    QCOMPARE(status.occupiedRangeEnd(300), 300);
+    QCOMPARE(status.occupiedRangeEnd(720), 960);
+
+    status.setOccupied(240, 720);
+    QCOMPARE(status.occupiedRangeEnd(0), 960);
+
+    status.setUnoccupied(0, 960);
+    QCOMPARE(status.occupiedRangeEnd(0), 0);
+}
+
 //---------------------------------------------------------
 //   events
 //---------------------------------------------------------
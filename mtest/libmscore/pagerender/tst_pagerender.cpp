@@ -0,0 +1,132 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  Copyright (C) 2020 MuseScore BVBA
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2
+//  as published by the Free Software Foundation and appearing in
+//  the file LICENCE.GPL
+//=============================================================================
+
+#include <QtTest/QtTest>
+#include "mtest/testutils.h"
+#include "libmscore/score.h"
+#include "libmscore/page.h"
+#include "libmscore/pagerender.h"
+
+using namespace Ms;
+
+//---------------------------------------------------------
+//   TestPageRender
+//---------------------------------------------------------
+
+class TestPageRender : public QObject, public MTest
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void renderImage();
+    void renderPdf_data();
+    void renderPdf();
+};
+
+//---------------------------------------------------------
+//   initTestCase
+//---------------------------------------------------------
+
+void TestPageRender::initTestCase()
+{
+    initMTest();
+}
+
+//---------------------------------------------------------
+//   renderImage
+//    png rendering without the editor
+//---------------------------------------------------------
+
+void TestPageRender::renderImage()
+{
+    MasterScore* score = readScore("libmscore/concertpitch/concertpitchbenchmark.mscx");
+    QVERIFY(score);
+    score->doLayout();
+    QVERIFY(!score->pages().isEmpty());
+    Page* page = score->pages().front();
+
+    QImage image = PageRender::image(page, 150.0);
+    QCOMPARE(image.width(), int(lrint(page->abbox().width() * 150.0 / DPI)));
+    QImage blank(image.size(), image.format());
+    blank.fill(0xffffffff);
+    QVERIFY(image != blank);
+
+    QImage trimmed = PageRender::image(page, 150.0, true, 4);
+    QVERIFY(trimmed.width() <= image.width());
+    QCOMPARE(qAlpha(trimmed.pixel(0, 0)), 0);
+    delete score;
+}
+
+//---------------------------------------------------------
+//   pdfPageCount
+//---------------------------------------------------------
+
+static int pdfPageCount(const QByteArray& pdf)
+{
+    static const QRegularExpression page("/Type\\s*/Page\\b");
+    int n = 0;
+    QRegularExpressionMatchIterator i = page.globalMatch(QString::fromLatin1(pdf));
+    while (i.hasNext()) {
+        i.next();
+        ++n;
+    }
+    return n;
+}
+
+//---------------------------------------------------------
+//   renderPdf
+//    pdf rendering without the editor; the pages are
+//    recorded concurrently or, with one thread, serially
+//---------------------------------------------------------
+
+void TestPageRender::renderPdf_data()
+{
+    QTest::addColumn<int>("threads");
+
+    QTest::newRow("serial") << 1;
+    QTest::newRow("concurrent") << QThread::idealThreadCount();
+}
+
+void TestPageRender::renderPdf()
+{
+    QFETCH(int, threads);
+
+    MasterScore* score = readScore("libmscore/concertpitch/concertpitchbenchmark.mscx");
+    QVERIFY(score);
+    score->doLayout();
+    const int pages = score->pages().size();
+    QVERIFY(pages > 1);
+
+    QThreadPool* pool = QThreadPool::globalInstance();
+    const int maxThreads = pool->maxThreadCount();
+    pool->setMaxThreadCount(threads);
+
+    QBuffer buffer;
+    buffer.open(QIODevice::WriteOnly);
+    QVERIFY(PageRender::pdf({ score }, &buffer, 300, "renderPdf"));
+    QVERIFY(buffer.data().startsWith("%PDF"));
+    QVERIFY(buffer.data().size() > 1024);
+    QCOMPARE(pdfPageCount(buffer.data()), pages);
+
+    // two scores in one document
+    QBuffer buffer2;
+    buffer2.open(QIODevice::WriteOnly);
+    QVERIFY(PageRender::pdf({ score, score }, &buffer2, 300, "renderPdf"));
+    QCOMPARE(pdfPageCount(buffer2.data()), 2 * pages);
+
+    pool->setMaxThreadCount(maxThreads);
+    delete score;
+}
+
+QTEST_MAIN(TestPageRender)
+#include "tst_pagerender.moc"
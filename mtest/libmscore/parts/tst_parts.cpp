@@ -14,6 +14,7 @@
 #include "libmscore/score.h"
 #include "libmscore/excerpt.h"
 #include "libmscore/part.h"
+#include "libmscore/instrument.h"
 #include "libmscore/undo.h"
 #include "libmscore/measure.h"
 #include "libmscore/chord.h"
@@ -62,6 +63,9 @@ private slots:
     void createPart1();
     void createPart2();
     void voicesExcerpt();
+    void deferredParts();
+    void deferredPartsCopy();
+    void createPartsLayout();
 
     void createPartBreath();
     void addBreath();
@@ -70,6 +74,7 @@ private slots:
     void removeBreath();
     void undoRemoveBreath();
     void undoRedoRemoveBreath();
+    void deferredPartLayout();
 
     void createPartFingering();
     void addFingering();
@@ -255,6 +260,68 @@ void TestParts::voicesExcerpt()
     delete score;
 }
 
+//---------------------------------------------------------
+//   deferredParts
+//    part scores are built on first access when
+//    MScore::deferExcerpts is set
+//---------------------------------------------------------
+
+void TestParts::deferredParts()
+{
+    MScore::deferExcerpts = true;
+    MasterScore* score = readScore(DIR + "part-all-parts.mscx");
+    MScore::deferExcerpts = false;
+    QVERIFY(score);
+
+    QCOMPARE(score->excerpts().size(), 2);
+    for (Excerpt* ex : score->excerpts()) {
+        QVERIFY(ex->isDeferred());
+        QVERIFY(!ex->title().isEmpty());
+    }
+    QCOMPARE(score->scoreList().size(), 1);
+
+    // channels changed while the part is deferred are synced on load
+    for (Part* p : score->parts()) {
+        Channel* c = p->instrument()->channel(0);
+        c->setChannel(c->channel() + 16);
+    }
+    Score* nscore = score->excerpts().at(1)->partScore();
+    QVERIFY(nscore);
+    for (Part* p : nscore->parts()) {
+        QCOMPARE(p->instrument()->channel(0)->channel(), p->masterPart()->instrument()->channel(0)->channel());
+    }
+    QVERIFY(!score->excerpts().at(1)->isDeferred());
+    QVERIFY(score->excerpts().at(0)->isDeferred());
+    QCOMPARE(score->scoreList().size(), 2);
+
+    QVERIFY(saveCompareScore(score, "part-all-deferred.mscx", DIR + "part-all-parts.mscx"));
+    QCOMPARE(score->scoreList().size(), 3);
+    delete score;
+}
+
+//---------------------------------------------------------
+//   deferredPartsCopy
+//    a copy of a deferred excerpt must have its parts
+//---------------------------------------------------------
+
+void TestParts::deferredPartsCopy()
+{
+    MScore::deferExcerpts = true;
+    MasterScore* score = readScore(DIR + "part-all-parts.mscx");
+    MScore::deferExcerpts = false;
+    QVERIFY(score);
+
+    Excerpt* ex = score->excerpts().at(0);
+    QVERIFY(ex->isDeferred());
+    Excerpt copy(*ex, false);
+    QVERIFY(!ex->isDeferred());
+    QVERIFY(!copy.parts().isEmpty());
+    QVERIFY(copy.parts() == ex->parts());
+    QVERIFY(copy.tracks() == ex->tracks());
+    QVERIFY(copy == *ex);
+    delete score;
+}
+
 //---------------------------------------------------------
 //   testPartCreation
 //---------------------------------------------------------
@@ -454,6 +521,56 @@ void TestParts::addBreath()
     delete score;
 }
 
+//---------------------------------------------------------
+//   createPartsLayout
+//    a new part score is laid out by createExcerpt(); the
+//    master score and the other parts are not scheduled
+//    for another layout
+//---------------------------------------------------------
+
+void TestParts::createPartsLayout()
+{
+    MasterScore* score = readScore(DIR + "part-all.mscx");
+    QVERIFY(score);
+    score->startCmd();
+    score->addLayoutFlags(LayoutFlag::FIX_PITCH_VELO);
+    createParts(score);
+    QVERIFY(!score->cmdState().layoutRange());
+    QVERIFY(score->cmdState()._excerptsChanged);
+    QVERIFY(score->cmdState().layoutFlags & LayoutFlag::FIX_PITCH_VELO);
+    for (Excerpt* ex : score->excerpts()) {
+        QVERIFY(!ex->partScore()->pages().isEmpty());
+    }
+    score->endCmd();
+    delete score;
+}
+
+//---------------------------------------------------------
+//   deferredPartLayout
+//    with MScore::deferPartLayout set, part scores without
+//    a view are laid out only on request
+//---------------------------------------------------------
+
+void TestParts::deferredPartLayout()
+{
+    MScore::deferPartLayout = true;
+    MasterScore* score = doAddBreath();
+    MScore::deferPartLayout = false;
+
+    QVERIFY(!score->layoutPending());
+    QVERIFY(!score->excerpts().isEmpty());
+    for (Excerpt* ex : score->excerpts()) {
+        QVERIFY(ex->partScore()->layoutPending());
+    }
+
+    score->doPendingPartsLayout();
+    for (Excerpt* ex : score->excerpts()) {
+        QVERIFY(!ex->partScore()->layoutPending());
+    }
+    QVERIFY(saveCompareScore(score, "part-breath-deferred.mscx", DIR + "part-breath-add.mscx"));
+    delete score;
+}
+
 //---------------------------------------------------------
 //   undoAddBreath
 //---------------------------------------------------------
@@ -14,6 +14,9 @@
 #include "mtest/testutils.h"
 #include "libmscore/score.h"
 #include "libmscore/undo.h"
+#include "libmscore/page.h"
+#include "libmscore/system.h"
+#include "libmscore/measure.h"
 
 #define DIR QString("libmscore/readwriteundoreset/")
 
@@ -34,6 +37,7 @@ private slots:
     void testReadWriteResetPositions();
 
     void testMMRestLinksRecreateMMRest();
+    void testThumbnail();
 };
 
 //---------------------------------------------------------
@@ -118,5 +122,62 @@ void TestReadWrite::testMMRestLinksRecreateMMRest()
     delete score;
 }
 
+//---------------------------------------------------------
+//   testThumbnail
+//    the thumbnail saved with the score is rendered again
+//    only if the first page changes
+//---------------------------------------------------------
+
+void TestReadWrite::testThumbnail()
+{
+    MasterScore* score = readScore("libmscore/concertpitch/concertpitchbenchmark.mscx");
+    QVERIFY(score);
+    score->doLayout();
+    QVERIFY(score->pages().size() > 1);
+
+    const QImage t1 = score->createThumbnail();
+    QVERIFY(!t1.isNull());
+    QCOMPARE(score->createThumbnail().cacheKey(), t1.cacheKey());
+
+    // layout of the last page keeps the thumbnail
+    score->startCmd();
+    score->setLayout(score->lastMeasure()->tick(), -1);
+    score->endCmd();
+    QCOMPARE(score->createThumbnail().cacheKey(), t1.cacheKey());
+
+    // layout of the first page renders it again
+    score->startCmd();
+    score->setLayout(Fraction(0, 1), -1);
+    score->endCmd();
+    const QImage t2 = score->createThumbnail();
+    QVERIFY(t2.cacheKey() != t1.cacheKey());
+    QCOMPARE(t2, t1);
+
+    // layout starting in the first measure of page two restarts
+    // one measure earlier, on page one
+    const Measure* m = score->pages().at(1)->systems().front()->firstMeasure();
+    QVERIFY(m);
+    score->startCmd();
+    score->setLayout(m->tick(), -1);
+    score->endCmd();
+    const QImage t3 = score->createThumbnail();
+    QVERIFY(t3.cacheKey() != t2.cacheKey());
+
+    // headers and footers are expanded from the meta tags
+    QMap<QString, QString> tags = score->metaTags();
+    tags.insert("copyright", "Thumbnail test");
+    score->startCmd();
+    score->undo(new ChangeMetaTags(score, tags));
+    score->endCmd();
+    const QImage t4 = score->createThumbnail();
+    QVERIFY(t4.cacheKey() != t3.cacheKey());
+
+    // and so is undoing the change
+    score->undoRedo(true, 0);
+    QVERIFY(score->createThumbnail().cacheKey() != t4.cacheKey());
+
+    delete score;
+}
+
 QTEST_MAIN(TestReadWrite)
 #include "tst_readwriteundoreset.moc"
@@ -0,0 +1,155 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  Copyright (C) 2020 MuseScore BVBA
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2
+//  as published by the Free Software Foundation and appearing in
+//  the file LICENCE.GPL
+//=============================================================================
+
+#include <QtTest/QtTest>
+#include "mtest/testutils.h"
+#include "libmscore/score.h"
+#include "libmscore/excerpt.h"
+#include "libmscore/scorecache.h"
+#include "libmscore/xml.h"
+
+using namespace Ms;
+
+//---------------------------------------------------------
+//   TestScoreCache
+//---------------------------------------------------------
+
+class TestScoreCache : public QObject, public MTest
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void cleanupTestCase();
+
+    void roundTrip_data();
+    void roundTrip();
+    void staleCache();
+    void deferredParts();
+};
+
+//---------------------------------------------------------
+//   initTestCase
+//---------------------------------------------------------
+
+void TestScoreCache::initTestCase()
+{
+    initMTest();
+    MScore::useScoreCache = true;
+}
+
+void TestScoreCache::cleanupTestCase()
+{
+    MScore::useScoreCache = false;
+}
+
+//---------------------------------------------------------
+//   roundTrip
+//    the first read creates the cache, the second read
+//    uses it; both must give the same score
+//---------------------------------------------------------
+
+void TestScoreCache::roundTrip_data()
+{
+    QTest::addColumn<QString>("path");
+
+    QTest::newRow("barlines") << "libmscore/readwriteundoreset/barlines.mscx";
+    QTest::newRow("slurs") << "libmscore/readwriteundoreset/slurs.mscx";
+    QTest::newRow("parts") << "libmscore/parts/part-all-parts.mscx";
+}
+
+void TestScoreCache::roundTrip()
+{
+    QFETCH(QString, path);
+
+    const QString file = QFileInfo(path).completeBaseName();
+    const QString scoreFile = file + "-cache.mscx";
+    const QString cacheFile = ScoreCache::cachePath(QFileInfo(scoreFile).absoluteFilePath());
+    QFile::remove(scoreFile);
+    QFile::remove(cacheFile);
+    QVERIFY(QFile::copy(root + "/" + path, scoreFile));
+
+    MasterScore* score = readCreatedScore(scoreFile);
+    QVERIFY(score);
+    QVERIFY(QFileInfo::exists(cacheFile));
+    QVERIFY(saveCompareScore(score, file + "-xml.mscx", path));
+    delete score;
+
+    score = readCreatedScore(scoreFile);
+    QVERIFY(score);
+    QVERIFY(saveCompareScore(score, file + "-cached.mscx", path));
+    delete score;
+}
+
+//---------------------------------------------------------
+//   staleCache
+//    a cache must not be used for changed score data
+//---------------------------------------------------------
+
+void TestScoreCache::staleCache()
+{
+    QFile f(root + "/libmscore/readwriteundoreset/barlines.mscx");
+    QVERIFY(f.open(QIODevice::ReadOnly));
+    QByteArray data = f.readAll();
+
+    XmlTokens tokens;
+    QVERIFY(ScoreCache::tokenize(data, &tokens));
+    QVERIFY(ScoreCache::write("stale.mscache", ScoreCache::checksum(data), tokens));
+
+    XmlTokens cached;
+    QVERIFY(ScoreCache::read("stale.mscache", ScoreCache::checksum(data), &cached));
+    QCOMPARE(cached.strings, tokens.strings);
+    QCOMPARE(cached.data, tokens.data);
+
+    data.replace("<Measure>", "<Measure >");
+    QVERIFY(!ScoreCache::read("stale.mscache", ScoreCache::checksum(data), &cached));
+}
+
+//---------------------------------------------------------
+//   deferredParts
+//    deferred part scores must keep their xml when the
+//    score is read from the cache
+//---------------------------------------------------------
+
+void TestScoreCache::deferredParts()
+{
+    const QString scoreFile = "parts-deferred.mscx";
+    const QString cacheFile = ScoreCache::cachePath(QFileInfo(scoreFile).absoluteFilePath());
+    QFile::remove(scoreFile);
+    QFile::remove(cacheFile);
+    QVERIFY(QFile::copy(root + "/libmscore/parts/part-all-parts.mscx", scoreFile));
+
+    MasterScore* score = readCreatedScore(scoreFile);
+    QVERIFY(score);
+    QVERIFY(QFileInfo::exists(cacheFile));
+    delete score;
+
+    MScore::deferExcerpts = true;
+    score = readCreatedScore(scoreFile);
+    MScore::deferExcerpts = false;
+    QVERIFY(score);
+
+    QCOMPARE(score->excerpts().size(), 2);
+    for (Excerpt* ex : score->excerpts()) {
+        QVERIFY(ex->isDeferred());
+        QVERIFY(!ex->title().isEmpty());
+    }
+    QVERIFY(saveCompareScore(score, "parts-deferred-cached.mscx", "libmscore/parts/part-all-parts.mscx"));
+    for (Excerpt* ex : score->excerpts()) {
+        QVERIFY(!ex->isDeferred());
+        QVERIFY(ex->partScore());
+    }
+    delete score;
+}
+
+QTEST_MAIN(TestScoreCache)
+#include "tst_scorecache.moc"
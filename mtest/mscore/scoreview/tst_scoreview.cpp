@@ -0,0 +1,123 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  Copyright (C) 2020 MuseScore BVBA and others
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2
+//  as published by the Free Software Foundation and appearing in
+//  the file LICENCE.GPL
+//=============================================================================
+
+#include <QtTest/QtTest>
+#include "mtest/testutils.h"
+#include "mscore/musescore.h"
+#include "mscore/scoreview.h"
+#include "libmscore/score.h"
+#include "libmscore/chord.h"
+#include "libmscore/note.h"
+#include "libmscore/segment.h"
+
+using namespace Ms;
+
+//---------------------------------------------------------
+//   TestScoreView
+//---------------------------------------------------------
+
+class TestScoreView : public QObject, public MTest
+{
+    Q_OBJECT
+
+    void initMuseScore();
+
+private slots:
+    void initTestCase();
+    void cleanupTestCase();
+
+    void pageTiles();
+};
+
+//---------------------------------------------------------
+//   TestScoreView::initTestCase
+//---------------------------------------------------------
+
+void TestScoreView::initTestCase()
+{
+    initMuseScore();
+}
+
+//---------------------------------------------------------
+//   TestScoreView::initMuseScore
+//---------------------------------------------------------
+
+void TestScoreView::initMuseScore()
+{
+    qputenv("QML_DISABLE_DISK_CACHE", "true");
+    qSetMessagePattern("%{function}: %{message}");
+    MScore::noGui = true;
+    MScore::testMode = true;
+    initMuseScoreResources();
+    QStringList temp;
+    MuseScore::init(temp);
+}
+
+//---------------------------------------------------------
+//   TestScoreView::cleanupTestCase
+//---------------------------------------------------------
+
+void TestScoreView::cleanupTestCase()
+{
+    qApp->processEvents();
+    delete Ms::mscore;
+    Ms::mscore = nullptr;
+}
+
+//---------------------------------------------------------
+//   TestScoreView::pageTiles
+//    a view painting from cached page tiles must show an
+//    edited note like a view painting without a cache
+//---------------------------------------------------------
+
+void TestScoreView::pageTiles()
+{
+    MasterScore* score = mscore->readScore(TESTROOT "/mtest/libmscore/concertpitch/concertpitchbenchmark.mscx");
+    QVERIFY(score);
+    score->doLayout();
+
+    Note* note = nullptr;
+    for (Segment* s = score->firstSegment(SegmentType::ChordRest); s && !note; s = s->next1(SegmentType::ChordRest)) {
+        Element* e = s->element(0);
+        if (e && e->isChord()) {
+            note = toChord(e)->upNote();
+        }
+    }
+    QVERIFY(note);
+
+    ScoreView* view = new ScoreView;
+    view->resize(800, 600);
+    view->setScore(score);
+    const QImage before = view->grab().toImage();       // fills the tile cache
+
+    score->startCmd();
+    note->undoChangeProperty(Pid::COLOR, QColor(Qt::red));
+    score->endCmd();
+    const QImage after = view->grab().toImage();
+    QVERIFY(after != before);
+
+    ScoreView* fresh = new ScoreView;
+    fresh->resize(800, 600);
+    fresh->setScore(score);
+    QCOMPARE(after, fresh->grab().toImage());
+
+    // undo must invalidate the tiles again
+    score->undoRedo(true, 0);
+    QCOMPARE(view->grab().toImage(), before);
+
+    delete fresh;
+    delete view;
+    delete score;
+}
+
+QTEST_MAIN(TestScoreView)
+#include "tst_scoreview.moc"
@@ -0,0 +1,165 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  Copyright (C) 2020 MuseScore BVBA and others
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2
+//  as published by the Free Software Foundation and appearing in
+//  the file LICENCE.GPL
+//=============================================================================
+
+#include <QtTest/QtTest>
+#include "mtest/testutils.h"
+#include "mscore/musescore.h"
+#include "mscore/preferences.h"
+#include "libmscore/score.h"
+
+using namespace Ms;
+
+//---------------------------------------------------------
+//   TestSvgExport
+//---------------------------------------------------------
+
+class TestSvgExport : public QObject, public MTest
+{
+    Q_OBJECT
+
+    void initMuseScore();
+
+private slots:
+    void initTestCase();
+    void cleanupTestCase();
+
+    void reusePaths();
+};
+
+//---------------------------------------------------------
+//   TestSvgExport::initTestCase
+//---------------------------------------------------------
+
+void TestSvgExport::initTestCase()
+{
+    initMuseScore();
+}
+
+//---------------------------------------------------------
+//   TestSvgExport::initMuseScore
+//---------------------------------------------------------
+
+void TestSvgExport::initMuseScore()
+{
+    qputenv("QML_DISABLE_DISK_CACHE", "true");
+    qSetMessagePattern("%{function}: %{message}");
+    MScore::noGui = true;
+    MScore::testMode = true;
+    initMuseScoreResources();
+    QStringList temp;
+    MuseScore::init(temp);
+}
+
+//---------------------------------------------------------
+//   TestSvgExport::cleanupTestCase
+//---------------------------------------------------------
+
+void TestSvgExport::cleanupTestCase()
+{
+    qApp->processEvents();
+    delete Ms::mscore;
+    Ms::mscore = nullptr;
+}
+
+//---------------------------------------------------------
+//   SvgStats
+//---------------------------------------------------------
+
+struct SvgStats {
+    int paths { 0 };              // drawn <path> elements
+    int defs { 0 };               // <path> elements inside <defs>
+    int uses { 0 };
+    bool undefinedUse { false };  // <use> of an id not defined before
+};
+
+//---------------------------------------------------------
+//   svgStats
+//    parse an exported page, fails on malformed xml
+//---------------------------------------------------------
+
+static bool svgStats(const QByteArray& svg, SvgStats* stats)
+{
+    QSet<QString> ids;
+    bool inDefs = false;
+    QXmlStreamReader r(svg);
+    while (!r.atEnd()) {
+        r.readNext();
+        if (r.isStartElement()) {
+            if (r.name() == "defs") {
+                inDefs = true;
+            } else if (r.name() == "path") {
+                if (inDefs) {
+                    ++stats->defs;
+                    ids.insert(r.attributes().value("id").toString());
+                } else {
+                    ++stats->paths;
+                }
+            } else if (r.name() == "use") {
+                ++stats->uses;
+                const QString href = r.attributes().value("http://www.w3.org/1999/xlink", "href").toString();
+                if (!href.startsWith('#') || !ids.contains(href.mid(1))) {
+                    stats->undefinedUse = true;
+                }
+            }
+        } else if (r.isEndElement() && r.name() == "defs") {
+            inDefs = false;
+        }
+    }
+    return !r.hasError();
+}
+
+//---------------------------------------------------------
+//   TestSvgExport::reusePaths
+//    with path reuse glyph outlines are defined once and
+//    drawn by <use>, and strokes are batched into fewer
+//    paths; without it the output has neither
+//---------------------------------------------------------
+
+void TestSvgExport::reusePaths()
+{
+    MasterScore* score = mscore->readScore(TESTROOT "/mtest/libmscore/concertpitch/concertpitchbenchmark.mscx");
+    QVERIFY(score);
+    score->doLayout();
+
+    const bool reuse = preferences.getBool(PREF_EXPORT_SVG_REUSEPATHS);
+
+    preferences.setPreference(PREF_EXPORT_SVG_REUSEPATHS, false);
+    QBuffer plain;
+    plain.open(QIODevice::WriteOnly);
+    QVERIFY(mscore->saveSvg(score, &plain, 0));
+
+    preferences.setPreference(PREF_EXPORT_SVG_REUSEPATHS, true);
+    QBuffer reused;
+    reused.open(QIODevice::WriteOnly);
+    QVERIFY(mscore->saveSvg(score, &reused, 0));
+
+    preferences.setPreference(PREF_EXPORT_SVG_REUSEPATHS, reuse);
+
+    SvgStats p;
+    QVERIFY(svgStats(plain.data(), &p));
+    QCOMPARE(p.defs, 0);
+    QCOMPARE(p.uses, 0);
+    QVERIFY(!plain.data().contains("<defs>"));
+
+    SvgStats r;
+    QVERIFY(svgStats(reused.data(), &r));
+    QVERIFY(r.defs > 0);
+    QVERIFY(r.uses > r.defs);                 // glyphs are used more than once
+    QVERIFY(!r.undefinedUse);
+    QVERIFY(r.paths + r.uses < p.paths);      // batched strokes
+    QVERIFY(reused.data().size() < plain.data().size());
+
+    delete score;
+}
+
+QTEST_MAIN(TestSvgExport)
+#include "tst_svgexport.moc"
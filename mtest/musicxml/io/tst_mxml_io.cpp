@@ -22,6 +22,7 @@
 
 namespace Ms {
 extern bool saveMxl(Score*, const QString&);
+extern bool saveXmlParts(const QList<Score*>&, const QStringList&, bool);
 }
 
 #define DIR QString("musicxml/io/")
@@ -43,6 +44,7 @@ class TestMxmlIO : public QObject, public MTest
     void mxmlMscxExportTestRefBreaks(const char* file);
     void mxmlReadTestCompr(const char* file);
     void mxmlReadWriteTestCompr(const char* file);
+    void mxmlParallelExportTest(const QStringList& files);
 
     // The list of MusicXML regression tests
     // Currently failing tests are commented out and annotated with the failure reason
@@ -108,6 +110,9 @@ private slots:
     void hello() { mxmlIoTest("testHello"); }
     void helloReadCompr() { mxmlReadTestCompr("testHello"); }
     void helloReadWriteCompr() { mxmlReadWriteTestCompr("testHello"); }
+    void helloParallelExport() { mxmlParallelExportTest({ "testHello", "testAccidentals1", "testBarStyles" }); }
+    void importParts_data();
+    void importParts();   // pass 1 with one thread and concurrently
     void implicitMeasure1() { mxmlIoTest("testImplicitMeasure1"); }
     void incorrectStaffNumber1() { mxmlIoTestRef("testIncorrectStaffNumber1"); }
     void incorrectStaffNumber2() { mxmlIoTestRef("testIncorrectStaffNumber2"); }
@@ -397,5 +402,83 @@ void TestMxmlIO::mxmlReadWriteTestCompr(const char* file)
     delete score;
 }
 
+//---------------------------------------------------------
+//   mxmlParallelExportTest
+//   read several MusicXML files, write them concurrently and verify files are identical
+//---------------------------------------------------------
+
+void TestMxmlIO::mxmlParallelExportTest(const QStringList& files)
+{
+    MScore::debugMode = true;
+    preferences.setCustomPreference<MusicxmlExportBreaks>(PREF_EXPORT_MUSICXML_EXPORTBREAKS,
+                                                          MusicxmlExportBreaks::MANUAL);
+    preferences.setPreference(PREF_IMPORT_MUSICXML_IMPORTBREAKS, true);
+    preferences.setPreference(PREF_EXPORT_MUSICXML_EXPORTLAYOUT, false);
+    QList<Score*> scores;
+    QStringList names;
+    for (const QString& file : files) {
+        MasterScore* score = readScore(DIR + file + ".xml");
+        QVERIFY(score);
+        fixupScore(score);
+        score->doLayout();
+        scores.append(score);
+        names.append(file + "_parallel.xml");
+    }
+    QVERIFY(saveXmlParts(scores, names, false));
+    for (int i = 0; i < files.size(); ++i) {
+        QVERIFY(compareFiles(names[i], DIR + files[i] + ".xml"));
+    }
+    qDeleteAll(scores);
+}
+
+//---------------------------------------------------------
+//   importParts
+//   read multi-part MusicXML files with the parts of pass 1
+//   parsed on one thread and concurrently, and verify the
+//   written files are identical to the originals
+//---------------------------------------------------------
+
+void TestMxmlIO::importParts_data()
+{
+    QTest::addColumn<int>("threads");
+
+    QTest::newRow("serial") << 1;
+    QTest::newRow("concurrent") << QThread::idealThreadCount();
+}
+
+void TestMxmlIO::importParts()
+{
+    QFETCH(int, threads);
+
+    MScore::debugMode = true;
+    preferences.setCustomPreference<MusicxmlExportBreaks>(PREF_EXPORT_MUSICXML_EXPORTBREAKS,
+                                                          MusicxmlExportBreaks::MANUAL);
+    preferences.setPreference(PREF_IMPORT_MUSICXML_IMPORTBREAKS, true);
+    preferences.setPreference(PREF_EXPORT_MUSICXML_EXPORTLAYOUT, false);
+    const QStringList files { "testSystemBrackets1", "testTrackHandling" };
+
+    QThreadPool* pool = QThreadPool::globalInstance();
+    const int maxThreads = pool->maxThreadCount();
+    pool->setMaxThreadCount(threads);
+    QList<MasterScore*> scores;
+    QBENCHMARK {
+        qDeleteAll(scores);
+        scores.clear();
+        for (const QString& file : files) {
+            scores.append(readScore(DIR + file + ".xml"));
+        }
+    }
+    pool->setMaxThreadCount(maxThreads);
+
+    for (int i = 0; i < files.size(); ++i) {
+        MasterScore* score = scores[i];
+        QVERIFY(score);
+        fixupScore(score);
+        score->doLayout();
+        QVERIFY(saveCompareMusicXmlScore(score, files[i] + ".xml", DIR + files[i] + ".xml"));
+    }
+    qDeleteAll(scores);
+}
+
 QTEST_MAIN(TestMxmlIO)
 #include "tst_mxml_io.moc"
@@ -0,0 +1,212 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  Copyright (C) 2020 MuseScore BVBA
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2
+//  as published by the Free Software Foundation and appearing in
+//  the file LICENCE.GPL
+//=============================================================================
+
+#include <QtTest/QtTest>
+
+#include "libmscore/score.h"
+#include "libmscore/page.h"
+#include "libmscore/pagerender.h"
+#include "mtest/testutils.h"
+
+using namespace Ms;
+
+//---------------------------------------------------------
+//   TestVTest
+//    renders the first page of all vtest scores which have
+//    a reference image at the resolution used by vtest/gen
+//    and compares it with the reference
+//
+//    It is skipped unless VTEST is set: the references are
+//    generated by older builds and differ with any change
+//    of the rendering.
+//
+//    VTEST             run the test
+//    VTEST_SRC         space separated test names, default all
+//    VTEST_TOLERANCE   allowed fraction of differing pixels
+//    VTEST_OUT         directory for the images of failed tests
+//---------------------------------------------------------
+
+class TestVTest : public QObject, public MTest
+{
+    Q_OBJECT
+
+    struct Job {
+        QString name;
+        QImage reference;
+        QImage image;
+        qint64 loadTime   { 0 };
+        qint64 layoutTime { 0 };
+        qint64 renderTime { 0 };
+        qint64 diffTime   { 0 };
+        double diff       { 0.0 };
+        QString error;
+    };
+
+    static void compare(Job& job);
+
+private slots:
+    void initTestCase() { initMTest(); }
+    void vtest();
+};
+
+static const qreal VTEST_DPI = 130.0;
+
+//---------------------------------------------------------
+//   luminance
+//    of a premultiplied pixel composed over white
+//---------------------------------------------------------
+
+static inline int luminance(QRgb p)
+{
+    const int white = 255 - qAlpha(p);
+    return (qRed(p) + white) * 11 + (qGreen(p) + white) * 16 + (qBlue(p) + white) * 5;
+}
+
+//---------------------------------------------------------
+//   compare
+//    a pixel differs if its luminance is off by more than
+//    a threshold from the reference pixel and from all
+//    its neighbours: antialiasing and one pixel shifts
+//    are no failures
+//---------------------------------------------------------
+
+void TestVTest::compare(Job& job)
+{
+    QElapsedTimer timer;
+    timer.start();
+    if (job.reference.size() != job.image.size()) {
+        job.error = QString("size %1x%2, reference %3x%4")
+                    .arg(job.image.width()).arg(job.image.height())
+                    .arg(job.reference.width()).arg(job.reference.height());
+        job.diff = 1.0;
+        job.diffTime = timer.elapsed();
+        return;
+    }
+    static const int THRESHOLD = 64 * 32;       // luminance is scaled by 32
+    const QImage ref = job.reference.convertToFormat(QImage::Format_ARGB32_Premultiplied);
+    const QImage& img = job.image;
+    const int w = img.width();
+    const int h = img.height();
+    qint64 failed = 0;
+    for (int y = 0; y < h; ++y) {
+        const QRgb* line = reinterpret_cast<const QRgb*>(img.constScanLine(y));
+        for (int x = 0; x < w; ++x) {
+            const int l = luminance(line[x]);
+            bool match = false;
+            for (int yy = qMax(0, y - 1); yy <= qMin(h - 1, y + 1) && !match; ++yy) {
+                const QRgb* refLine = reinterpret_cast<const QRgb*>(ref.constScanLine(yy));
+                for (int xx = qMax(0, x - 1); xx <= qMin(w - 1, x + 1); ++xx) {
+                    if (qAbs(luminance(refLine[xx]) - l) <= THRESHOLD) {
+                        match = true;
+                        break;
+                    }
+                }
+            }
+            if (!match) {
+                ++failed;
+            }
+        }
+    }
+    job.diff = w * h ? double(failed) / (double(w) * h) : 0.0;
+    job.diffTime = timer.elapsed();
+}
+
+//---------------------------------------------------------
+//   vtest
+//---------------------------------------------------------
+
+void TestVTest::vtest()
+{
+    if (!qEnvironmentVariableIsSet("VTEST")) {
+        QSKIP("set VTEST to compare with the vtest reference images");
+    }
+    const QString dir = root + "/../vtest/";
+    QStringList names;
+    const QString src = QString::fromLocal8Bit(qgetenv("VTEST_SRC"));
+    if (!src.isEmpty()) {
+        names = src.split(' ', QString::SkipEmptyParts);
+    } else {
+        for (const QString& ref : QDir(dir).entryList({ "*-ref.png" }, QDir::Files, QDir::Name)) {
+            const QString name = ref.left(ref.size() - 8);
+            if (QFileInfo::exists(dir + name + ".mscx")) {
+                names.append(name);
+            }
+        }
+    }
+    QVERIFY(!names.isEmpty());
+    bool ok;
+    double tolerance = qgetenv("VTEST_TOLERANCE").toDouble(&ok);
+    if (!ok) {
+        tolerance = 0.001;
+    }
+
+    std::vector<Job> jobs(names.size());
+    for (int i = 0; i < names.size(); ++i) {
+        jobs[i].name = names[i];
+    }
+
+    // decoding the references does not touch libmscore
+    QFuture<void> references = QtConcurrent::map(jobs, [&dir](Job& job) {
+                                                      job.reference = QImage(dir + job.name + "-ref.png");
+                                                  });
+
+    // layout is not thread safe, scores are loaded and laid out one by one;
+    // rendering paints the page in concurrent bands and comparing runs
+    // in the background while the next score is loaded
+    QFutureSynchronizer<void> diffs;
+    QElapsedTimer total;
+    total.start();
+    for (Job& job : jobs) {
+        QElapsedTimer timer;
+        timer.start();
+        MasterScore* score = readCreatedScore(dir + job.name + ".mscx");
+        job.loadTime = timer.restart();
+        if (!score) {
+            job.error = "cannot read score";
+            continue;
+        }
+        score->doLayout();
+        job.layoutTime = timer.restart();
+        if (score->pages().isEmpty()) {
+            job.error = "no pages";
+            delete score;
+            continue;
+        }
+        job.image = PageRender::image(score->pages().front(), VTEST_DPI, true);
+        job.renderTime = timer.elapsed();
+        delete score;
+
+        references.waitForFinished();
+        diffs.addFuture(QtConcurrent::run([&job]() { compare(job); }));
+    }
+    diffs.waitForFinished();
+
+    const QString out = QString::fromLocal8Bit(qgetenv("VTEST_OUT"));
+    QStringList failed;
+    qInfo("%-36s %8s %8s %8s %8s %10s", "test", "load", "layout", "render", "diff", "pixels");
+    for (const Job& job : jobs) {
+        qInfo("%-36s %6lldms %6lldms %6lldms %6lldms %9.4f%%", qPrintable(job.name),
+              job.loadTime, job.layoutTime, job.renderTime, job.diffTime, job.diff * 100.0);
+        if (!job.error.isEmpty() || job.reference.isNull() || job.diff > tolerance) {
+            failed.append(job.error.isEmpty() ? job.name : job.name + ": " + job.error);
+            if (!out.isEmpty() && !job.image.isNull()) {
+                QDir().mkpath(out);
+                job.image.save(out + "/" + job.name + "-1.png");
+            }
+        }
+    }
+    qInfo("%d tests in %lldms", int(jobs.size()), total.elapsed());
+    QVERIFY2(failed.isEmpty(), qPrintable(failed.join(", ")));
+}
+
+QTEST_MAIN(TestVTest)
+#include "tst_vtest.moc"
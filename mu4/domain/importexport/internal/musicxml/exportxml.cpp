@@ -35,6 +35,7 @@
 // Currently all output (both debug and error reports) are done using qDebug.
 
 #include <math.h>
+#include <QtConcurrent>
 #include "config.h"
 
 #include "musicxml.h"
@@ -315,6 +316,7 @@ struct MeasurePrintContext final
 
 typedef QHash<const ChordRest* const, const Trill*> TrillHash;
 typedef QMap<const Instrument*, int> MxmlInstrumentMap;
+typedef QList<int> IntVector;
 
 class ExportMusicXml
 {
@@ -335,6 +337,7 @@ class ExportMusicXml
     TrillHash _trillStart;
     TrillHash _trillStop;
     MxmlInstrumentMap instrMap;
+    IntVector _integers;          // time values collected by calcDivisions()
 
     int findBracket(const TextLineBase* tl) const;
     int findDashes(const TextLineBase* tl) const;
@@ -1039,13 +1042,9 @@ static void findTrills(const Measure* const measure, int strack, int etrack, Tri
 // helpers for ::calcDivisions
 //---------------------------------------------------------
 
-typedef QList<int> IntVector;
-static IntVector integers;
-static IntVector primes;
-
 // check if all integers can be divided by d
 
-static bool canDivideBy(int d)
+static bool canDivideBy(const IntVector& integers, int d)
 {
     bool res = true;
     for (int i = 0; i < integers.count(); i++) {
@@ -1058,14 +1057,14 @@ static bool canDivideBy(int d)
 
 // divide all integers by d
 
-static void divideBy(int d)
+static void divideBy(IntVector& integers, int d)
 {
     for (int i = 0; i < integers.count(); i++) {
         integers[i] /= d;
     }
 }
 
-static void addInteger(int len)
+static void addInteger(IntVector& integers, int len)
 {
     if (!integers.contains(len)) {
         integers.append(len);
@@ -1082,12 +1081,12 @@ void ExportMusicXml::calcDivMoveToTick(const Fraction& t)
 #ifdef DEBUG_TICK
         qDebug("backup %d", (tick - t).ticks());
 #endif
-        addInteger((_tick - t).ticks());
+        addInteger(_integers, (_tick - t).ticks());
     } else if (t > _tick) {
 #ifdef DEBUG_TICK
         qDebug("forward %d", (t - tick).ticks());
 #endif
-        addInteger((t - _tick).ticks());
+        addInteger(_integers, (t - _tick).ticks());
     }
     _tick = t;
 }
@@ -1121,12 +1120,9 @@ static bool isTwoNoteTremolo(Chord* chord)
 void ExportMusicXml::calcDivisions()
 {
     // init
-    integers.clear();
-    primes.clear();
-    integers.append(MScore::division);
-    primes.append(2);
-    primes.append(3);
-    primes.append(5);
+    _integers.clear();
+    _integers.append(MScore::division);
+    const IntVector primes { 2, 3, 5 };
 
     const QList<Part*>& il = _score->parts();
 
@@ -1179,7 +1175,7 @@ void ExportMusicXml::calcDivisions()
 #ifdef DEBUG_TICK
                         qDebug("chordrest %d", l);
 #endif
-                        addInteger(l.ticks());
+                        addInteger(_integers, l.ticks());
                         _tick += l;
                     }
                 }
@@ -1191,14 +1187,14 @@ void ExportMusicXml::calcDivisions()
 
     // do it: divide by all primes as often as possible
     for (int u = 0; u < primes.count(); u++) {
-        while (canDivideBy(primes[u])) {
-            divideBy(primes[u]);
+        while (canDivideBy(_integers, primes[u])) {
+            divideBy(_integers, primes[u]);
         }
     }
 
-    div = MScore::division / integers[0];
+    div = MScore::division / _integers[0];
 #ifdef DEBUG_TICK
-    qDebug("divisions=%d div=%d", integers[0], div);
+    qDebug("divisions=%d div=%d", _integers[0], div);
 #endif
 }
 
@@ -6737,6 +6733,7 @@ void ExportMusicXml::write(QIODevice* dev)
     writeParts();
 
     _xml.etag();
+    _xml.flush();
 
     if (concertPitch) {
         // restore concert pitch
@@ -6813,12 +6810,13 @@ static void writeMxlArchive(Score* score, MQZipWriter& zipwriter, const QString&
     //uz.addDirectory("META-INF");
     zipwriter.addFile("META-INF/container.xml", cbuf.data());
 
-    QBuffer dbuf;
-    dbuf.open(QIODevice::ReadWrite);
-    ExportMusicXml em(score);
-    em.write(&dbuf);
-    dbuf.seek(0);
-    zipwriter.addFile(filename, dbuf.data());
+    // the score is deflated into the archive while it is written
+    QIODevice* dev = zipwriter.startFile(filename);
+    if (dev) {
+        ExportMusicXml em(score);
+        em.write(dev);
+    }
+    zipwriter.finishFile();
 }
 
 bool saveMxl(Score* score, QIODevice* device)
@@ -6844,6 +6842,58 @@ bool saveMxl(Score* score, const QString& name)
     return true;
 }
 
+//---------------------------------------------------------
+//   saveXmlParts
+//    return false on error
+//---------------------------------------------------------
+
+/**
+ Save each of \a scores as (compressed) MusicXML file in \a names.
+ Pending layouts of the scores are done first, then the scores
+ are exported concurrently, as the exporter only reads from the score.
+
+ Return false on error.
+ */
+
+bool saveXmlParts(const QList<Score*>& scores, const QStringList& names, bool compressed)
+{
+    auto save = [compressed](Score* score, const QString& name) {
+                    return compressed ? saveMxl(score, name) : saveXml(score, name);
+                };
+
+    // the export reads system and page breaks; layout is not
+    // thread safe and must be complete before the export starts
+    for (Score* score : scores) {
+        score->doPendingLayout();
+    }
+
+    // exporting in concert pitch temporarily changes the score
+    // through the undo stack shared by all parts
+    bool parallel = true;
+    for (Score* score : scores) {
+        if (score->styleB(Sid::concertPitch)) {
+            parallel = false;
+        }
+    }
+
+    bool res = true;
+    if (!parallel) {
+        for (int i = 0; i < scores.size(); ++i) {
+            res &= save(scores[i], names[i]);
+        }
+        return res;
+    }
+
+    QList<QFuture<bool> > futures;
+    for (int i = 0; i < scores.size(); ++i) {
+        futures.append(QtConcurrent::run(save, scores[i], names[i]));
+    }
+    for (QFuture<bool>& f : futures) {
+        res &= f.result();
+    }
+    return res;
+}
+
 double ExportMusicXml::getTenthsFromInches(double inches) const
 {
     return inches * INCH / millimeters * tenths;
@@ -17,11 +17,11 @@ namespace Ms {
 //   xmlLocation
 //---------------------------------------------------------
 
-static QString xmlLocation(const QXmlStreamReader* const xmlreader)
+static QString xmlLocation(const QXmlStreamReader* const xmlreader, const int lineOffset)
 {
     QString loc;
     if (xmlreader) {
-        loc = QString(" at line %1 col %2").arg(xmlreader->lineNumber()).arg(xmlreader->columnNumber());
+        loc = QString(" at line %1 col %2").arg(xmlreader->lineNumber() + lineOffset).arg(xmlreader->columnNumber());
     }
     return loc;
 }
@@ -30,7 +30,7 @@ static QString xmlLocation(const QXmlStreamReader* const xmlreader)
 //   logDebugTrace
 //---------------------------------------------------------
 
-static void log(MxmlLogger::Level level, const QString& text, const QXmlStreamReader* const xmlreader)
+static void log(MxmlLogger::Level level, const QString& text, const QXmlStreamReader* const xmlreader, const int lineOffset)
 {
     QString str;
     switch (level) {
@@ -44,7 +44,7 @@ static void log(MxmlLogger::Level level, const QString& text, const QXmlStreamRe
         break;
     }
 
-    str += xmlLocation(xmlreader);
+    str += xmlLocation(xmlreader, lineOffset);
     str += ": ";
     str += text;
 
@@ -62,7 +62,7 @@ static void log(MxmlLogger::Level level, const QString& text, const QXmlStreamRe
 void MxmlLogger::logDebugTrace(const QString& trace, const QXmlStreamReader* const xmlreader)
 {
     if (_level <= Level::MXML_TRACE) {
-        log(Level::MXML_TRACE, trace, xmlreader);
+        log(Level::MXML_TRACE, trace, xmlreader, _lineOffset);
     }
 }
 
@@ -77,7 +77,7 @@ void MxmlLogger::logDebugTrace(const QString& trace, const QXmlStreamReader* con
 void MxmlLogger::logDebugInfo(const QString& info, const QXmlStreamReader* const xmlreader)
 {
     if (_level <= Level::MXML_INFO) {
-        log(Level::MXML_INFO, info, xmlreader);
+        log(Level::MXML_INFO, info, xmlreader, _lineOffset);
     }
 }
 
@@ -92,7 +92,7 @@ void MxmlLogger::logDebugInfo(const QString& info, const QXmlStreamReader* const
 void MxmlLogger::logError(const QString& error, const QXmlStreamReader* const xmlreader)
 {
     if (_level <= Level::MXML_ERROR) {
-        log(Level::MXML_ERROR, error, xmlreader);
+        log(Level::MXML_ERROR, error, xmlreader, _lineOffset);
     }
 }
 }
@@ -27,8 +27,11 @@ public:
     void logDebugInfo(const QString& info, const QXmlStreamReader* const xmlreader = 0);
     void logError(const QString& error, const QXmlStreamReader* const xmlreader = 0);
     void setLoggingLevel(const Level level) { _level = level; }
+    void setLineOffset(const int offset) { _lineOffset = offset; }
+    int lineOffset() const { return _lineOffset; }
 private:
     Level _level = Level::MXML_INFO;
+    int _lineOffset = 0;           ///< Added to the line numbers of the xml reader
 };
 } // namespace Ms
 
@@ -17,6 +17,9 @@
 //  Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
 //=============================================================================
 
+#include <QtConcurrent>
+#include <QTextCodec>
+
 #include "libmscore/box.h"
 #include "libmscore/chordrest.h"
 #include "libmscore/instrtemplate.h"
@@ -784,16 +787,38 @@ static void fixupSigmap(MxmlLogger* logger, Score* score, const QVector<Fraction
 //   parse
 //---------------------------------------------------------
 
+/**
+ Decode the MusicXML document in \a data using the encoding
+ given by its byte order mark or XML declaration.
+ */
+
+static QString decodeDocument(const QByteArray& data)
+{
+    QTextCodec* codec = QTextCodec::codecForName("UTF-8");
+    QXmlStreamReader xml(data);
+    if (xml.readNext() == QXmlStreamReader::StartDocument && !xml.documentEncoding().isEmpty()) {
+        QTextCodec* declared = QTextCodec::codecForName(xml.documentEncoding().toLatin1());
+        if (declared) {
+            codec = declared;
+        }
+    }
+    return QTextCodec::codecForUtfText(data, codec)->toUnicode(data);
+}
+
 /**
  Parse MusicXML in \a device and extract pass 1 data.
+ The document is decoded up front, so that the parts can be
+ parsed concurrently from slices of its text.
  */
 
 Score::FileError MusicXMLParserPass1::parse(QIODevice* device)
 {
     _logger->logDebugTrace("MusicXMLParserPass1::parse device");
     _parts.clear();
-    _e.setDevice(device);
+    _text = decodeDocument(device->readAll());
+    _e.addData(_text);
     auto res = parse();
+    _text.clear();
     if (res != Score::FileError::FILE_NO_ERROR) {
         return res;
     }
@@ -878,10 +903,11 @@ void MusicXMLParserPass1::scorePartwise()
     _logger->logDebugTrace("MusicXMLParserPass1::scorePartwise", &_e);
 
     MusicXmlPartGroupList partGroupList;
+    QList<PartSource> partSources;
 
     while (_e.readNextStartElement()) {
         if (_e.name() == "part") {
-            part();
+            partSources.append(partSource());
         } else if (_e.name() == "part-list") {
             partList(partGroupList);
         } else if (_e.name() == "work") {
@@ -909,6 +935,8 @@ void MusicXMLParserPass1::scorePartwise()
         }
     }
 
+    parseParts(partSources);
+
     // add brackets where required
 
     /*
@@ -1957,8 +1985,6 @@ void MusicXMLParserPass1::part()
         }
     }
 
-    // Bug fix for Cubase 6.5.5..9.5.10 which generate <staff>2</staff> in a single staff part
-    setNumberOfStavesForPart(_partMap.value(id), _parts[id].maxStaff());
     // allocate MuseScore staff to MusicXML voices
     allocateStaves(_parts[id].voicelist);
     // allocate MuseScore voice to MusicXML voices
@@ -1994,6 +2020,96 @@ void MusicXMLParserPass1::part()
     */
 }
 
+//---------------------------------------------------------
+//   partSource
+//---------------------------------------------------------
+
+/**
+ Skip the /score-partwise/part node, returning its id and text.
+ The line offset of the text is returned too, to keep the line
+ numbers in error messages identical to those in the document.
+ */
+
+MusicXMLParserPass1::PartSource MusicXMLParserPass1::partSource()
+{
+    Q_ASSERT(_e.isStartElement() && _e.name() == "part");
+
+    PartSource source;
+    source.id = _e.attributes().value("id").toString().trimmed();
+
+    // attribute values cannot contain '<', so this finds the start of the tag
+    const int tagEnd = int(_e.characterOffset());
+    const int start = _text.lastIndexOf('<', tagEnd - 1);
+    const int line = int(_e.lineNumber()) - _text.midRef(start, tagEnd - start).count('\n');
+    _e.skipCurrentElement();
+    const int end = int(_e.characterOffset());
+
+    source.xml = _text.mid(start, end - start);
+    source.lineOffset = qMax(line - 1, 0);
+    return source;
+}
+
+//---------------------------------------------------------
+//   parseParts
+//---------------------------------------------------------
+
+/**
+ Parse the parts in \a sources concurrently, each by a parser of
+ its own, and merge the results in document order.
+ A part parser only sees the entries of its own part.
+ */
+
+void MusicXMLParserPass1::parseParts(const QList<PartSource>& sources)
+{
+    // each part parser logs with the line offset of its part
+    std::vector<MxmlLogger> loggers(sources.size(), *_logger);
+    for (int i = 0; i < sources.size(); ++i) {
+        loggers[i].setLineOffset(sources[i].lineOffset);
+    }
+
+    auto partParser = [this](const PartSource& source, MxmlLogger* logger, int divs) {
+                          MusicXMLParserPass1* p = new MusicXMLParserPass1(_score, logger);
+                          p->_parts.insert(source.id, _parts.value(source.id));
+                          p->_partMap.insert(source.id, _partMap.value(source.id));
+                          p->_divs = divs;
+                          p->_e.addData(source.xml);
+                          return p;
+                      };
+    auto parsePart = [](MusicXMLParserPass1* p) {
+                         if (p->_e.readNextStartElement()) {
+                             p->part();
+                         }
+                     };
+
+    QList<MusicXMLParserPass1*> parsers;
+    for (int i = 0; i < sources.size(); ++i) {
+        parsers.append(partParser(sources[i], &loggers[i], 0));
+    }
+    QtConcurrent::blockingMap(parsers, parsePart);
+
+    for (int i = 0; i < parsers.size(); ++i) {
+        // a part without divisions continues with those of the previous part
+        if (parsers[i]->_inheritsDivs && _divs > 0) {
+            delete parsers[i];
+            parsers[i] = partParser(sources[i], &loggers[i], _divs);
+            parsePart(parsers[i]);
+        }
+        const MusicXMLParserPass1* p = parsers[i];
+        const QString& id = sources[i].id;
+
+        _parts[id] = p->_parts.value(id);
+        _pageStartMeasureNrs.insert(p->_pageStartMeasureNrs.begin(), p->_pageStartMeasureNrs.end());
+        _systemStartMeasureNrs.insert(p->_systemStartMeasureNrs.begin(), p->_systemStartMeasureNrs.end());
+        for (const auto& ts : p->_timeSigs) {
+            _score->sigmap()->add(ts.first.ticks(), ts.second);
+        }
+        // Bug fix for Cubase 6.5.5..9.5.10 which generate <staff>2</staff> in a single staff part
+        setNumberOfStavesForPart(_partMap.value(id), qMax(p->_nstaves, _parts[id].maxStaff()));
+        _divs = p->_divs;
+    }
+    qDeleteAll(parsers);
+}
+
 //---------------------------------------------------------
 //   measureDurationAsFraction
 //---------------------------------------------------------
@@ -2339,7 +2455,7 @@ void MusicXMLParserPass1::time(const Fraction cTime)
         int btp = 0;           // beat-type as integer
         if (determineTimeSig(_logger, &_e, beats, beatType, timeSymbol, st, bts, btp)) {
             _timeSigDura = Fraction(bts, btp);
-            _score->sigmap()->add(cTime.ticks(), _timeSigDura);
+            _timeSigs.append({ cTime, _timeSigDura });
         }
     }
 }
@@ -2381,7 +2497,7 @@ void MusicXMLParserPass1::staves(const QString& partId)
         return;
     }
 
-    setNumberOfStavesForPart(_partMap.value(partId), staves);
+    _nstaves = qMax(_nstaves, staves);
 }
 
 //---------------------------------------------------------
@@ -2409,7 +2525,7 @@ void MusicXMLParserPass1::direction(const QString& partId, const Fraction cTime)
         if (_e.name() == "direction-type") {
             directionType(cTime, starts, stops);
         } else if (_e.name() == "staff") {
-            int nstaves = getPart(partId)->nstaves();
+            int nstaves = qMax(getPart(partId)->nstaves(), _nstaves);
             QString strStaff = _e.readElementText();
             staff = strStaff.toInt() - 1;
             if (0 <= staff && staff < nstaves) {
@@ -2984,6 +3100,9 @@ void MusicXMLParserPass1::note(const QString& partId,
     QString instrId;
     MxmlStartStop tupletStartStop { MxmlStartStop::NONE };
 
+    if (_divs <= 0) {
+        _inheritsDivs = true;
+    }
     mxmlNoteDuration mnd(_divs, _logger);
 
     while (_e.readNextStartElement()) {
@@ -3024,7 +3143,7 @@ void MusicXMLParserPass1::note(const QString& partId,
             _parts[partId].setMaxStaff(staff);
             Part* part = _partMap.value(partId);
             Q_ASSERT(part);
-            if (!ok || staff <= 0 || staff > part->nstaves()) {
+            if (!ok || staff <= 0 || staff > qMax(part->nstaves(), _nstaves)) {
                 _logger->logError(QString("illegal staff '%1'").arg(strStaff), &_e);
             }
         } else if (_e.name() == "stem") {
@@ -3101,7 +3220,7 @@ void MusicXMLParserPass1::note(const QString& partId,
     }
 
     if (!(_e.isEndElement() && _e.name() == "note")) {
-        qDebug("name %s line %lld", qPrintable(_e.name().toString()), _e.lineNumber());
+        qDebug("name %s line %lld", qPrintable(_e.name().toString()), _e.lineNumber() + _logger->lineOffset());
     }
     Q_ASSERT(_e.isEndElement() && _e.name() == "note");
 }
@@ -3167,6 +3286,7 @@ void MusicXMLParserPass1::duration(Fraction& dura)
             dura.set(intDura, 4 * _divs);
             dura.reduce();       // prevent overflow in later Fraction operations
         } else {
+            _inheritsDivs = true;
             _logger->logError("illegal or uninitialized divisions", &_e);
         }
     } else {
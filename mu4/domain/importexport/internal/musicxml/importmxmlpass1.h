@@ -167,11 +167,20 @@ public:
     const CreditWordsList& credits() const { return _credits; }
 
 private:
+    struct PartSource {
+        QString id;
+        QString xml;
+        int lineOffset;                         ///< Number of document lines before the part
+    };
+
     // functions
     void setFirstInstr(const QString& id, const Fraction stime);
+    PartSource partSource();
+    void parseParts(const QList<PartSource>& sources);
 
     // generic pass 1 data
     QXmlStreamReader _e;
+    QString _text;                              ///< Document text, parts are parsed from slices of it
     int _divs;                                  ///< Current MusicXML divisions value
     QMap<QString, MusicXmlPart> _parts;         ///< Parts data, mapped on part id
     std::set<int> _systemStartMeasureNrs;       ///< Measure numbers of measures starting a page
@@ -189,6 +198,9 @@ private:
     QMap<int, MxmlOctaveShiftDesc> _octaveShifts;   ///< Pending octave-shifts
     Fraction _firstInstrSTime;                  ///< First instrument start time
     QString _firstInstrId;                      ///< First instrument id
+    int _nstaves = 0;                           ///< Number of staves according to <staves> read
+    QList<QPair<Fraction, Fraction> > _timeSigs;    ///< Time signatures read, added to the sigmap after parsing
+    bool _inheritsDivs = false;                 ///< Durations were read before any divisions
     QSize _pageSize;                            ///< Page width read from defaults
 };
 } // namespace Ms
@@ -513,6 +513,88 @@ public:
     MQZipReader::Status status;
 };
 
+//---------------------------------------------------------
+//   MQZipDeflateDevice
+//    write-only device deflating everything written to it
+//    straight into the archive device
+//---------------------------------------------------------
+
+class MQZipDeflateDevice : public QIODevice
+{
+public:
+    explicit MQZipDeflateDevice(QIODevice *out)
+        : out(out)
+    {
+        memset(&stream, 0, sizeof(z_stream));
+        valid = deflateInit2(&stream, Z_DEFAULT_COMPRESSION, Z_DEFLATED, -MAX_WBITS, 8, Z_DEFAULT_STRATEGY) == Z_OK;
+        crc = ::crc32(0, 0, 0);
+        open(QIODevice::WriteOnly);
+    }
+    ~MQZipDeflateDevice()
+    {
+        if (valid)
+            deflateEnd(&stream);
+    }
+
+    bool finish()
+    {
+        QIODevice::close();
+        if (!valid)
+            return false;
+        stream.next_in = 0;
+        stream.avail_in = 0;
+        bool res = pump(Z_FINISH);
+        deflateEnd(&stream);
+        valid = false;
+        return res;
+    }
+
+    uint crc;
+    qint64 compressedSize = 0;
+    qint64 uncompressedSize = 0;
+
+protected:
+    qint64 readData(char *, qint64) override { return -1; }
+
+    qint64 writeData(const char *data, qint64 len) override
+    {
+        if (!valid)
+            return -1;
+        crc = ::crc32(crc, (const uchar *)data, len);
+        uncompressedSize += len;
+        stream.next_in = (Bytef *)data;
+        stream.avail_in = (uInt)len;
+        if (!pump(Z_NO_FLUSH)) {
+            valid = false;
+            return -1;
+        }
+        return len;
+    }
+
+private:
+    bool pump(int flush)
+    {
+        char buf[16384];
+        int err;
+        do {
+            stream.next_out = (Bytef *)buf;
+            stream.avail_out = sizeof(buf);
+            err = ::deflate(&stream, flush);
+            if (err == Z_STREAM_ERROR)
+                return false;
+            qint64 n = sizeof(buf) - stream.avail_out;
+            if (n && out->write(buf, n) != n)
+                return false;
+            compressedSize += n;
+        } while (stream.avail_out == 0 || (flush == Z_FINISH && err != Z_STREAM_END));
+        return true;
+    }
+
+    QIODevice *out;
+    z_stream stream;
+    bool valid;
+};
+
 class MQZipWriterPrivate : public MQZipPrivate
 {
 public:
@@ -530,7 +612,15 @@ public:
 
     enum EntryType { Directory, File, Symlink };
 
+    void initHeader(FileHeader &header, EntryType type, const QString &fileName);
     void addEntry(EntryType type, const QString &fileName, const QByteArray &contents);
+
+    QIODevice *startEntry(const QString &fileName);
+    void finishEntry();
+
+    // entry currently streamed by startEntry()
+    MQZipDeflateDevice *entryDevice = nullptr;
+    FileHeader entryHeader;
 };
 
 LocalFileHeader CentralFileHeader::toLocalHeader() const
@@ -638,6 +728,53 @@ void MQZipReaderPrivate::scanFiles()
     }
 }
 
+void MQZipWriterPrivate::initHeader(FileHeader &header, EntryType type, const QString &fileName)
+{
+    memset(&header.h, 0, sizeof(CentralFileHeader));
+    writeUInt(header.h.signature, 0x02014b50);
+
+    writeUShort(header.h.version_needed, ZIP_VERSION);
+    writeMSDosDate(header.h.last_mod_file, QDateTime::currentDateTime());
+
+    // if bit 11 is set, the filename and comment fields must be encoded using UTF-8
+    ushort general_purpose_bits = Utf8Names; // always use utf-8
+    writeUShort(header.h.general_purpose_bits, general_purpose_bits);
+
+    const bool inUtf8 = (general_purpose_bits & Utf8Names) != 0;
+    header.file_name = inUtf8 ? fileName.toUtf8() : fileName.toLocal8Bit();
+    if (header.file_name.size() > 0xffff) {
+        qWarning("QZip: Filename is too long, chopping it to 65535 bytes");
+        header.file_name = header.file_name.left(0xffff); // ### don't break the utf-8 sequence, if any
+    }
+    if (header.file_comment.size() + header.file_name.size() > 0xffff) {
+        qWarning("QZip: File comment is too long, chopping it to 65535 bytes");
+        header.file_comment.truncate(0xffff - header.file_name.size()); // ### don't break the utf-8 sequence, if any
+    }
+    writeUShort(header.h.file_name_length, header.file_name.length());
+    //h.extra_field_length[2];
+
+    writeUShort(header.h.version_made, HostUnix << 8);
+    //uchar internal_file_attributes[2];
+    //uchar external_file_attributes[4];
+    quint32 mode = permissionsToMode(permissions);
+    switch (type) {
+    case Symlink:
+        mode |= UnixFileAttributes::SymLink;
+        break;
+    case Directory:
+        mode |= UnixFileAttributes::Dir;
+        break;
+    case File:
+        mode |= UnixFileAttributes::File;
+        break;
+    default:
+        Q_UNREACHABLE();
+        break;
+    }
+    writeUInt(header.h.external_file_attributes, mode << 16);
+    writeUInt(header.h.offset_local_header, start_of_directory);
+}
+
 void MQZipWriterPrivate::addEntry(EntryType type, const QString &fileName, const QByteArray &contents/*, QFile::Permissions permissions, QZip::Method m*/)
 {
 #ifndef NDEBUG
@@ -648,6 +785,7 @@ void MQZipWriterPrivate::addEntry(EntryType type, const QString &fileName, const
     ZDEBUG() << "adding" << entryTypes[type] <<":" << fileName.toUtf8().data() << (type == 2 ? QByteArray(" -> " + contents).constData() : "");
 #endif
 
+    finishEntry();
     if (! (device->isOpen() || device->open(QIODevice::WriteOnly))) {
         status = MQZipWriter::FileOpenError;
         return;
@@ -664,12 +802,8 @@ void MQZipWriterPrivate::addEntry(EntryType type, const QString &fileName, const
     }
 
     FileHeader header;
-    memset(&header.h, 0, sizeof(CentralFileHeader));
-    writeUInt(header.h.signature, 0x02014b50);
-
-    writeUShort(header.h.version_needed, ZIP_VERSION);
+    initHeader(header, type, fileName);
     writeUInt(header.h.uncompressed_size, contents.length());
-    writeMSDosDate(header.h.last_mod_file, QDateTime::currentDateTime());
     QByteArray data = contents;
     if (compression == MQZipWriter::AlwaysCompress) {
         writeUShort(header.h.compression_method, CompressionMethodDeflated);
@@ -702,45 +836,6 @@ void MQZipWriterPrivate::addEntry(EntryType type, const QString &fileName, const
     crc_32 = ::crc32(crc_32, (const uchar *)contents.constData(), contents.length());
     writeUInt(header.h.crc_32, crc_32);
 
-    // if bit 11 is set, the filename and comment fields must be encoded using UTF-8
-    ushort general_purpose_bits = Utf8Names; // always use utf-8
-    writeUShort(header.h.general_purpose_bits, general_purpose_bits);
-
-    const bool inUtf8 = (general_purpose_bits & Utf8Names) != 0;
-    header.file_name = inUtf8 ? fileName.toUtf8() : fileName.toLocal8Bit();
-    if (header.file_name.size() > 0xffff) {
-        qWarning("QZip: Filename is too long, chopping it to 65535 bytes");
-        header.file_name = header.file_name.left(0xffff); // ### don't break the utf-8 sequence, if any
-    }
-    if (header.file_comment.size() + header.file_name.size() > 0xffff) {
-        qWarning("QZip: File comment is too long, chopping it to 65535 bytes");
-        header.file_comment.truncate(0xffff - header.file_name.size()); // ### don't break the utf-8 sequence, if any
-    }
-    writeUShort(header.h.file_name_length, header.file_name.length());
-    //h.extra_field_length[2];
-
-    writeUShort(header.h.version_made, HostUnix << 8);
-    //uchar internal_file_attributes[2];
-    //uchar external_file_attributes[4];
-    quint32 mode = permissionsToMode(permissions);
-    switch (type) {
-    case Symlink:
-        mode |= UnixFileAttributes::SymLink;
-        break;
-    case Directory:
-        mode |= UnixFileAttributes::Dir;
-        break;
-    case File:
-        mode |= UnixFileAttributes::File;
-        break;
-    default:
-        Q_UNREACHABLE();
-        break;
-    }
-    writeUInt(header.h.external_file_attributes, mode << 16);
-    writeUInt(header.h.offset_local_header, start_of_directory);
-
-
     fileHeaders.append(header);
 
     LocalFileHeader h = header.h.toLocalHeader();
@@ -751,6 +846,52 @@ void MQZipWriterPrivate::addEntry(EntryType type, const QString &fileName, const
     dirtyFileTree = true;
 }
 
+QIODevice *MQZipWriterPrivate::startEntry(const QString &fileName)
+{
+    ZDEBUG() << "streaming file:" << fileName.toUtf8().data();
+
+    if (! (device->isOpen() || device->open(QIODevice::WriteOnly))) {
+        status = MQZipWriter::FileOpenError;
+        return nullptr;
+    }
+    device->seek(start_of_directory);
+
+    initHeader(entryHeader, File, fileName);
+    writeUShort(entryHeader.h.compression_method, CompressionMethodDeflated);
+
+    // sizes and crc are not known yet; finishEntry() rewrites the local header
+    LocalFileHeader h = entryHeader.h.toLocalHeader();
+    device->write((const char *)&h, sizeof(LocalFileHeader));
+    device->write(entryHeader.file_name);
+
+    entryDevice = new MQZipDeflateDevice(device);
+    return entryDevice;
+}
+
+void MQZipWriterPrivate::finishEntry()
+{
+    if (!entryDevice)
+        return;
+    if (!entryDevice->finish())
+        status = MQZipWriter::FileWriteError;
+
+    writeUInt(entryHeader.h.crc_32, entryDevice->crc);
+    writeUInt(entryHeader.h.compressed_size, entryDevice->compressedSize);
+    writeUInt(entryHeader.h.uncompressed_size, entryDevice->uncompressedSize);
+    delete entryDevice;
+    entryDevice = nullptr;
+
+    qint64 end = device->pos();
+    LocalFileHeader h = entryHeader.h.toLocalHeader();
+    device->seek(start_of_directory);
+    device->write((const char *)&h, sizeof(LocalFileHeader));
+    device->seek(end);
+
+    fileHeaders.append(entryHeader);
+    start_of_directory = end;
+    dirtyFileTree = true;
+}
+
 //////////////////////////////  Reader
 
 /*!
@@ -928,6 +1069,17 @@ MQZipReader::FileInfo MQZipReader::entryInfoAt(int index) const
 */
 QByteArray MQZipReader::fileData(const QString &fileName) const
 {
+    return uncompress(rawFileData(fileName));
+}
+
+/*!
+    Fetch the still compressed file contents from the zip archive.
+    Only this step touches the underlying device; the result can be
+    passed to uncompress() from any thread.
+*/
+MQZipReader::RawData MQZipReader::rawFileData(const QString &fileName) const
+{
+    RawData raw;
     d->scanFiles();
     int i;
     for (i = 0; i < d->fileHeaders.size(); ++i) {
@@ -935,14 +1087,14 @@ QByteArray MQZipReader::fileData(const QString &fileName) const
             break;
     }
     if (i == d->fileHeaders.size())
-        return QByteArray();
+        return raw;
 
     FileHeader header = d->fileHeaders.at(i);
 
     ushort version_needed = readUShort(header.h.version_needed);
     if (version_needed > ZIP_VERSION) {
         qWarning("QZip: .ZIP specification version %d implementationis needed to extract the data.", version_needed);
-        return QByteArray();
+        return raw;
     }
 
     ushort general_purpose_bits = readUShort(header.h.general_purpose_bits);
@@ -962,19 +1114,37 @@ QByteArray MQZipReader::fileData(const QString &fileName) const
 
     if ((general_purpose_bits & Encrypted) != 0) {
         qWarning("QZip: Unsupported encryption method is needed to extract the data.");
-        return QByteArray();
+        return raw;
     }
 
     //qDebug("file at %lld", d->device->pos());
-    QByteArray compressed = d->device->read(compressed_size);
-    if (compression_method == CompressionMethodStored) {
+    raw.data = d->device->read(compressed_size);
+    raw.data.truncate(compressed_size);
+    raw.compressionMethod = compression_method;
+    raw.uncompressedSize = uncompressed_size;
+    raw.valid = true;
+    return raw;
+}
+
+/*!
+    Return the uncompressed bytes of \a raw as fetched by rawFileData().
+    This function does not access the archive and is thread safe.
+*/
+QByteArray MQZipReader::uncompress(const RawData &raw)
+{
+    if (!raw.valid)
+        return QByteArray();
+
+    QByteArray compressed = raw.data;
+    int compressed_size = compressed.size();
+    int uncompressed_size = raw.uncompressedSize;
+    if (raw.compressionMethod == CompressionMethodStored) {
         // no compression
         compressed.truncate(uncompressed_size);
         return compressed;
-    } else if (compression_method == CompressionMethodDeflated) {
+    } else if (raw.compressionMethod == CompressionMethodDeflated) {
         // Deflate
         //qDebug("compressed=%d", compressed.size());
-        compressed.truncate(compressed_size);
         QByteArray baunzip;
         ulong len = qMax(uncompressed_size,  1);
         int res;
@@ -1002,7 +1172,7 @@ QByteArray MQZipReader::fileData(const QString &fileName) const
         return baunzip;
     }
 
-    qWarning("QZip: Unsupported compression method %d is needed to extract the data.", compression_method);
+    qWarning("QZip: Unsupported compression method %d is needed to extract the data.", raw.compressionMethod);
     return QByteArray();
 }
 
@@ -1293,6 +1463,30 @@ void MQZipWriter::addFile(const QString &fileName, QIODevice *device)
         device->close();
 }
 
+/*!
+    Start a new file in the archive stored as \a fileName and return a
+    device its contents can be written to. The data is deflated and written
+    to the archive while it arrives, so it never has to be held in memory.
+    The returned device is owned by the writer and stays valid until
+    finishFile() is called or another file is added.
+    This requires the archive device to be seekable.
+
+    \sa finishFile()
+*/
+QIODevice *MQZipWriter::startFile(const QString &fileName)
+{
+    d->finishEntry();
+    return d->startEntry(QDir::fromNativeSeparators(fileName));
+}
+
+/*!
+    Complete the file started with startFile().
+*/
+void MQZipWriter::finishFile()
+{
+    d->finishEntry();
+}
+
 /*!
     Create a new directory in the archive with the specified \a dirName and
     the \a permissions;
@@ -1321,6 +1515,7 @@ void MQZipWriter::addSymLink(const QString &fileName, const QString &destination
 */
 void MQZipWriter::close()
 {
+    d->finishEntry();
     if (!(d->device->openMode() & QIODevice::WriteOnly)) {
         d->device->close();
         return;
@@ -99,6 +99,17 @@ public:
 
     FileInfo entryInfoAt(int index) const;
     QByteArray fileData(const QString &fileName) const;
+
+    struct RawData
+    {
+        QByteArray data;
+        int compressionMethod = 0;
+        int uncompressedSize = 0;
+        bool valid = false;
+    };
+
+    RawData rawFileData(const QString &fileName) const;
+    static QByteArray uncompress(const RawData &raw);
     bool extractAll(const QString &destinationDir) const;
 
     enum Status {
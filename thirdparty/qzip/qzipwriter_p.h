@@ -101,6 +101,9 @@ public:
 
     void addFile(const QString &fileName, QIODevice *device);
 
+    QIODevice *startFile(const QString &fileName);
+    void finishFile();
+
     void addDirectory(const QString &dirName);
 
     void addSymLink(const QString &fileName, const QString &destination);